@@ -0,0 +1,66 @@
+// BatchPlanner throughput: the same batch of A* queries on a 300x300 grid with
+// 1, 2, 4, 8 and 16 worker threads, compared with a plain sequential loop
+// over AStar::search on the Graph.
+#include "sf/path_planning.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace {
+
+sf::Graph makeGrid(int side, std::mt19937& rng) {
+    std::uniform_real_distribution<double> weight(1.0, 10.0);
+    sf::Graph graph;
+    for (int i = 0; i < side * side; i++) {
+        graph.addNode(sf::Node(i, i % side, i / side));
+    }
+    for (int i = 0; i < side * side; i++) {
+        if (i % side + 1 < side) graph.addEdgeUndirected(i, i + 1, weight(rng));
+        if (i / side + 1 < side) graph.addEdgeUndirected(i, i + side, weight(rng));
+    }
+    return graph;
+}
+
+} // namespace
+
+int main() {
+    const int side = 300;
+    const int queries = 500;
+    std::mt19937 rng(42);
+    sf::Graph graph = makeGrid(side, rng);
+    sf::CompactGraph compact = graph.freeze();
+
+    std::uniform_int_distribution<int> pick(0, side * side - 1);
+    std::vector<sf::PlanRequest> requests;
+    for (int i = 0; i < queries; i++) {
+        requests.emplace_back(pick(rng), pick(rng), sf::PlanAlgorithm::AStar);
+    }
+
+    std::cout << "A* batch, grid " << side << "x" << side << " (" << queries << " queries, "
+              << sf::ThreadPool::defaultThreadCount() << " hardware threads)\n";
+
+    auto begin = std::chrono::steady_clock::now();
+    double checksum = 0.0;
+    for (int i = 0; i < queries / 10; i++) {
+        checksum += sf::AStar::search(graph, requests[i].startId, requests[i].goalId).cost;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << "  " << std::left << std::setw(24) << "Graph loop (1/10 batch)" << std::right
+              << std::setw(12) << std::fixed << std::setprecision(0) << (queries / 10) / seconds
+              << " queries/s\n";
+
+    std::vector<sf::PathResult> results;
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        sf::BatchPlanner planner(compact, threads);
+        planner.run(requests, results);  // warm up the per-worker workspaces
+        sf::BatchStats stats = planner.run(requests, results);
+        std::cout << "  " << std::left << std::setw(24)
+                  << ("BatchPlanner x" + std::to_string(threads)) << std::right
+                  << std::setw(12) << std::setprecision(0) << stats.queriesPerSecond
+                  << " queries/s   (" << stats.found << " found, "
+                  << stats.nodesExplored << " nodes)\n";
+    }
+    (void)checksum;
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Delta-stepping benchmark: full single-source shortest paths on a 1000x1000
+// grid, sequential indexed-heap Dijkstra versus DeltaStepping with 1, 2, 4, 8
+// and 16 threads.
+#include "sf/path_planning.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace {
+
+sf::Graph makeGrid(int side, std::mt19937& rng) {
+    std::uniform_real_distribution<double> weight(1.0, 10.0);
+    sf::Graph graph;
+    for (int i = 0; i < side * side; i++) {
+        graph.addNode(sf::Node(i, i % side, i / side));
+    }
+    for (int i = 0; i < side * side; i++) {
+        if (i % side + 1 < side) graph.addEdgeUndirected(i, i + 1, weight(rng));
+        if (i / side + 1 < side) graph.addEdgeUndirected(i, i + side, weight(rng));
+    }
+    return graph;
+}
+
+// Sequential baseline: exhaustive Dijkstra with the indexed 4-ary heap
+double dijkstraChecksum(const sf::CompactGraph& graph, int source) {
+    std::vector<double> dist(graph.nodeCount(), std::numeric_limits<double>::infinity());
+    sf::IndexedDaryHeap<4> heap(graph.nodeCount());
+    dist[source] = 0.0;
+    heap.push(source, 0.0);
+    double checksum = 0.0;
+    while (!heap.empty()) {
+        int current = heap.pop();
+        checksum += dist[current];
+        for (size_t e = graph.edgeBegin(current); e < graph.edgeEnd(current); e++) {
+            int next = graph.edgeTarget(e);
+            double d = dist[current] + graph.edgeWeight(e);
+            if (d < dist[next]) {
+                dist[next] = d;
+                heap.pushOrDecrease(next, d);
+            }
+        }
+    }
+    return checksum;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+} // namespace
+
+int main() {
+    const int side = 1000;
+    std::mt19937 rng(42);
+    sf::CompactGraph compact = makeGrid(side, rng).freeze();
+    const int source = side * (side / 2) + side / 2;
+
+    std::cout << "Full SSSP, grid " << side << "x" << side << " ("
+              << sf::ThreadPool::defaultThreadCount() << " hardware threads)\n";
+    std::cout << std::fixed;
+
+    auto begin = std::chrono::steady_clock::now();
+    double expected = dijkstraChecksum(compact, source);
+    double baseline = secondsSince(begin);
+    std::cout << "  " << std::left << std::setw(20) << "Dijkstra" << std::right
+              << std::setw(10) << std::setprecision(3) << baseline << " s\n";
+
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        sf::DeltaStepping sssp(threads);
+        begin = std::chrono::steady_clock::now();
+        sf::ShortestPathTree tree = sssp.run(compact, compact.idOf(source));
+        double seconds = secondsSince(begin);
+
+        double checksum = 0.0;
+        for (double d : tree.distance) {
+            checksum += d;
+        }
+        std::cout << "  " << std::left << std::setw(20)
+                  << ("delta-stepping x" + std::to_string(threads)) << std::right
+                  << std::setw(10) << std::setprecision(3) << seconds << " s   speedup "
+                  << std::setprecision(2) << baseline / seconds
+                  << (std::abs(checksum - expected) < 1e-6 * expected ? "" : "   MISMATCH")
+                  << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,158 @@
+// Replanning benchmark: a robot crosses a 1000x1000 grid (1M cells) and every
+// step a few cells just ahead of it become blocked. Each replan is timed for
+// the persistent DStarPlanner and DStarLitePlanner and for a full A* recompute
+// over the same edge costs (what the one-shot update() entry points do).
+#include "sf/path_planning.h"
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+
+namespace {
+
+// 4-connected grid with weights in [1, 3]; the euclidean heuristic is consistent
+sf::CompactGraph makeGrid(int side, std::mt19937& rng) {
+    std::uniform_real_distribution<double> weight(1.0, 3.0);
+    sf::Graph graph;
+    for (int i = 0; i < side * side; i++) {
+        graph.addNode(sf::Node(i, i % side, i / side));
+    }
+    for (int i = 0; i < side * side; i++) {
+        if (i % side + 1 < side) graph.addEdgeUndirected(i, i + 1, weight(rng));
+        if (i / side + 1 < side) graph.addEdgeUndirected(i, i + side, weight(rng));
+    }
+    return graph.freeze();
+}
+
+// CompactGraph topology with the planner's current edge costs, for the engine
+class CostView {
+public:
+    CostView(const sf::CompactGraph& graph, const std::vector<double>& costs)
+        : graph(graph), costs(costs) {}
+
+    size_t nodeCount() const { return graph.nodeCount(); }
+    bool contains(int id) const { return graph.hasNode(id); }
+    int handle(int id) const { return graph.indexOf(id); }
+    int id(int node) const { return graph.idOf(node); }
+    sf::Node node(int node) const { return graph.node(node); }
+    bool mayReach(int, int) const { return true; }
+
+    template <typename F>
+    void forEachEdge(int node, F&& f) const {
+        for (size_t e = graph.edgeBegin(node); e < graph.edgeEnd(node); e++) {
+            if (costs[e] != std::numeric_limits<double>::infinity()) {
+                f(graph.edgeTarget(e), costs[e]);
+            }
+        }
+    }
+
+    double edgeCost(int from, int to) const {
+        for (size_t e = graph.edgeBegin(from); e < graph.edgeEnd(from); e++) {
+            if (graph.edgeTarget(e) == to) {
+                return costs[e];
+            }
+        }
+        return 0.0;
+    }
+
+private:
+    const sf::CompactGraph& graph;
+    const std::vector<double>& costs;
+};
+
+double millisecondsSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin)
+        .count();
+}
+
+} // namespace
+
+int main() {
+    const int side = 1000;
+    const int steps = 30;
+    const int blockedPerStep = 3;
+    std::mt19937 rng(42);
+    sf::CompactGraph compact = makeGrid(side, rng);
+    std::vector<double> costs(compact.edgeCount());
+    for (size_t e = 0; e < costs.size(); e++) {
+        costs[e] = compact.edgeWeight(e);
+    }
+
+    const int start = 10 * side + 10;
+    const int goal = (side - 10) * side + side - 10;
+    sf::DStarLitePlanner planner(compact, start, goal);
+    auto begin = std::chrono::steady_clock::now();
+    sf::PathResult path = planner.plan();
+    std::cout << "grid " << side << "x" << side << ", initial plan " << std::fixed
+              << std::setprecision(1) << millisecondsSince(begin) << " ms, "
+              << path.nodesExplored << " expansions (D* Lite)\n";
+    sf::DStarPlanner dstar(compact, start, goal);
+    begin = std::chrono::steady_clock::now();
+    sf::PathResult dstarPath = dstar.plan();
+    std::cout << "grid " << side << "x" << side << ", initial plan " << std::fixed
+              << std::setprecision(1) << millisecondsSince(begin) << " ms, "
+              << dstarPath.nodesExplored << " expansions (D*)\n";
+
+    sf::SearchWorkspace workspace;
+    double incrementalMs = 0.0;
+    double recomputeMs = 0.0;
+    size_t incrementalExpanded = 0;
+    size_t recomputeExpanded = 0;
+    double dstarMs = 0.0;
+    size_t dstarExpanded = 0;
+    double checksum = 0.0;
+    for (int step = 0; step < steps && path.found && path.path.size() > 20; step++) {
+        planner.moveStart(path.path[1]);
+        dstar.moveStart(path.path[1]);
+
+        // Block a few cells 5-15 steps ahead on the current path
+        std::uniform_int_distribution<size_t> ahead(5, 15);
+        for (int k = 0; k < blockedPerStep; k++) {
+            int cell = compact.indexOf(path.path[ahead(rng)]);
+            if (cell == compact.indexOf(goal)) {
+                continue;
+            }
+            for (size_t in = compact.reverseBegin(cell); in < compact.reverseEnd(cell); in++) {
+                int from = compact.reverseSource(in);
+                costs[compact.reverseEdge(in)] = std::numeric_limits<double>::infinity();
+                planner.updateEdgeCost(compact.idOf(from), compact.idOf(cell),
+                                       std::numeric_limits<double>::infinity());
+                dstar.removeEdge(compact.idOf(from), compact.idOf(cell));
+            }
+        }
+
+        begin = std::chrono::steady_clock::now();
+        path = planner.plan();
+        incrementalMs += millisecondsSince(begin);
+        incrementalExpanded += path.nodesExplored;
+
+        begin = std::chrono::steady_clock::now();
+        dstarPath = dstar.plan();
+        dstarMs += millisecondsSince(begin);
+        dstarExpanded += dstarPath.nodesExplored;
+
+        begin = std::chrono::steady_clock::now();
+        sf::engine::IndexedHeapQueue open(workspace.indexedHeap());
+        sf::engine::DenseVisited visited(workspace);
+        sf::PathResult full = sf::engine::run(CostView(compact, costs), open, visited,
+                                              sf::engine::EuclideanHeuristic(),
+                                              planner.start(), goal);
+        recomputeMs += millisecondsSince(begin);
+        recomputeExpanded += full.nodesExplored;
+        checksum += std::abs(path.cost - full.cost) + std::abs(dstarPath.cost - full.cost);
+    }
+
+    std::cout << "  " << std::left << std::setw(22) << "full A* recompute" << std::right
+              << std::setw(9) << std::setprecision(3) << recomputeMs / steps << " ms/replan  "
+              << std::setw(9) << recomputeExpanded / steps << " expansions/replan\n";
+    std::cout << "  " << std::left << std::setw(22) << "DStarPlanner" << std::right
+              << std::setw(9) << dstarMs / steps << " ms/replan  " << std::setw(9)
+              << dstarExpanded / steps << " expansions/replan\n";
+    std::cout << "  " << std::left << std::setw(22) << "DStarLitePlanner" << std::right
+              << std::setw(9) << incrementalMs / steps << " ms/replan  " << std::setw(9)
+              << incrementalExpanded / steps << " expansions/replan\n";
+    std::cout << "  cost difference " << std::setprecision(6) << checksum << "\n";
+    return 0;
+}
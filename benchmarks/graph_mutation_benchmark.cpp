@@ -0,0 +1,112 @@
+// Edge mutation benchmark: random weight updates, removals and node blocks
+// on a 700x700 grid (490k nodes), by handle, by scanning the neighbour list
+// for the edge, and with the change log on. Then the log is replayed into a
+// DStarPlanner, as a dynamic-obstacle pipeline would.
+#include "sf/path_planning.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace {
+
+double millisecondsSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin)
+        .count();
+}
+
+void report(const char* name, size_t operations, double ms) {
+    std::cout << "  " << std::left << std::setw(30) << name << std::right << std::setw(9)
+              << std::fixed << std::setprecision(1) << operations / ms / 1000.0
+              << " M ops/s\n";
+}
+
+} // namespace
+
+int main() {
+    const int side = 700;
+    const size_t updates = 2000000;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> weight(1.0, 3.0);
+
+    sf::Graph graph;
+    for (int i = 0; i < side * side; i++) {
+        graph.addNode(sf::Node(i, i % side, i / side));
+    }
+    std::vector<sf::EdgeHandle> handles;
+    for (int i = 0; i < side * side; i++) {
+        if (i % side + 1 < side) {
+            auto pair = graph.addEdgeUndirected(i, i + 1, weight(rng));
+            handles.push_back(pair.first);
+            handles.push_back(pair.second);
+        }
+        if (i / side + 1 < side) {
+            auto pair = graph.addEdgeUndirected(i, i + side, weight(rng));
+            handles.push_back(pair.first);
+            handles.push_back(pair.second);
+        }
+    }
+    std::cout << "grid " << side << "x" << side << ", " << graph.edgeCount() << " edges, "
+              << updates << " operations each\n";
+    std::uniform_int_distribution<size_t> pick(0, handles.size() - 1);
+
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < updates; i++) {
+        graph.setEdgeWeight(handles[pick(rng)], weight(rng));
+    }
+    report("setEdgeWeight by handle", updates, millisecondsSince(begin));
+
+    begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < updates; i++) {
+        const sf::Edge& edge = graph.getEdge(handles[pick(rng)]);
+        graph.setEdgeWeight(graph.findEdge(edge.from, edge.to), weight(rng));
+    }
+    report("setEdgeWeight via findEdge", updates, millisecondsSince(begin));
+
+    std::uniform_int_distribution<int> cell(0, side * side - 1);
+    begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < updates / 2; i++) {
+        int id = cell(rng);
+        graph.blockNode(id);
+        graph.blockNode(id, false);
+    }
+    report("blockNode / unblock", updates, millisecondsSince(begin));
+
+    graph.recordChanges();
+    begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < updates; i++) {
+        graph.setEdgeWeight(handles[pick(rng)], weight(rng));
+    }
+    report("setEdgeWeight, change log on", updates, millisecondsSince(begin));
+    graph.recordChanges(false);
+
+    // A planner kept in step with the graph through the log
+    sf::CompactGraph compact = graph.freeze();
+    const int start = 10 * side + 10;
+    const int goal = (side - 10) * side + side - 10;
+    sf::DStarPlanner planner(compact, start, goal);
+    planner.plan();
+    graph.recordChanges();
+    const size_t batch = 1000;
+    const int rounds = 20;
+    double applyMs = 0.0;
+    double planMs = 0.0;
+    for (int round = 0; round < rounds; round++) {
+        uint64_t seen = graph.version();
+        for (size_t i = 0; i < batch; i++) {
+            graph.setEdgeWeight(handles[pick(rng)], weight(rng));
+        }
+        begin = std::chrono::steady_clock::now();
+        for (const auto& change : graph.changesSince(seen)) {
+            planner.updateEdgeCost(change.from, change.to, change.weight);
+        }
+        applyMs += millisecondsSince(begin);
+        begin = std::chrono::steady_clock::now();
+        planner.plan();
+        planMs += millisecondsSince(begin);
+        graph.trimChanges(graph.version());
+    }
+    std::cout << "  DStarPlanner, " << batch << " changes per round: " << std::setprecision(3)
+              << applyMs / rounds << " ms to apply, " << planMs / rounds << " ms to replan\n";
+    return 0;
+}
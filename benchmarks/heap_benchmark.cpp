@@ -0,0 +1,219 @@
+// Priority-queue benchmark: lazy-deletion std::priority_queue versus the
+// indexed d-ary heap with decrease-key, both driving a full single-source
+// Dijkstra over a CompactGraph, followed by the Dijkstra::search queue
+// policies on an integer-weight grid.
+#include "sf/path_planning.h"
+#include "sf/indexed_heap.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+
+namespace {
+
+struct Stats {
+    size_t pushes = 0;
+    size_t decreaseKeys = 0;
+    size_t stalePops = 0;
+    size_t maxHeapSize = 0;
+    double checksum = 0.0;
+};
+
+// Dijkstra as it is written in the Graph searches: duplicates plus a visited check
+Stats runLazy(const sf::CompactGraph& graph, int source) {
+    Stats stats;
+    std::vector<double> dist(graph.nodeCount(), std::numeric_limits<double>::infinity());
+    std::vector<char> visited(graph.nodeCount(), 0);
+    
+    using Pair = std::pair<double, int>;
+    std::priority_queue<Pair, std::vector<Pair>, std::greater<Pair>> pq;
+    
+    dist[source] = 0.0;
+    pq.push({0.0, source});
+    stats.pushes++;
+    
+    while (!pq.empty()) {
+        stats.maxHeapSize = std::max(stats.maxHeapSize, pq.size());
+        int current = pq.top().second;
+        pq.pop();
+        if (visited[current]) {
+            stats.stalePops++;
+            continue;
+        }
+        visited[current] = 1;
+        stats.checksum += dist[current];
+        
+        for (size_t e = graph.edgeBegin(current); e < graph.edgeEnd(current); e++) {
+            int next = graph.edgeTarget(e);
+            double d = dist[current] + graph.edgeWeight(e);
+            if (d < dist[next]) {
+                dist[next] = d;
+                pq.push({d, next});
+                stats.pushes++;
+            }
+        }
+    }
+    return stats;
+}
+
+template <unsigned Arity>
+Stats runIndexed(const sf::CompactGraph& graph, int source) {
+    Stats stats;
+    std::vector<double> dist(graph.nodeCount(), std::numeric_limits<double>::infinity());
+    sf::IndexedDaryHeap<Arity> pq(graph.nodeCount());
+    
+    dist[source] = 0.0;
+    pq.push(source, 0.0);
+    stats.pushes++;
+    
+    while (!pq.empty()) {
+        stats.maxHeapSize = std::max(stats.maxHeapSize, pq.size());
+        int current = pq.pop();
+        stats.checksum += dist[current];
+        
+        for (size_t e = graph.edgeBegin(current); e < graph.edgeEnd(current); e++) {
+            int next = graph.edgeTarget(e);
+            double d = dist[current] + graph.edgeWeight(e);
+            if (d < dist[next]) {
+                if (pq.contains(next)) {
+                    stats.decreaseKeys++;
+                } else {
+                    stats.pushes++;
+                }
+                dist[next] = d;
+                pq.pushOrDecrease(next, d);
+            }
+        }
+    }
+    return stats;
+}
+
+sf::Graph makeGrid(int side, std::mt19937& rng) {
+    std::uniform_real_distribution<double> weight(1.0, 10.0);
+    sf::Graph graph;
+    for (int i = 0; i < side * side; i++) {
+        graph.addNode(sf::Node(i, i % side, i / side));
+    }
+    for (int i = 0; i < side * side; i++) {
+        if (i % side + 1 < side) graph.addEdgeUndirected(i, i + 1, weight(rng));
+        if (i / side + 1 < side) graph.addEdgeUndirected(i, i + side, weight(rng));
+    }
+    return graph;
+}
+
+sf::Graph makeDense(int nodes, int degree, std::mt19937& rng) {
+    std::uniform_real_distribution<double> weight(1.0, 100.0);
+    std::uniform_int_distribution<int> pick(0, nodes - 1);
+    sf::Graph graph;
+    for (int i = 0; i < nodes; i++) {
+        graph.addNode(sf::Node(i, 0, 0));
+    }
+    for (int i = 0; i < nodes; i++) {
+        for (int k = 0; k < degree; k++) {
+            graph.addEdge(i, pick(rng), weight(rng));
+        }
+    }
+    return graph;
+}
+
+template <typename Fn>
+void report(const std::string& name, const sf::CompactGraph& graph,
+            const std::vector<int>& sources, Fn run) {
+    Stats total;
+    auto begin = std::chrono::steady_clock::now();
+    for (int s : sources) {
+        Stats st = run(graph, s);
+        total.pushes += st.pushes;
+        total.decreaseKeys += st.decreaseKeys;
+        total.stalePops += st.stalePops;
+        total.maxHeapSize = std::max(total.maxHeapSize, st.maxHeapSize);
+        total.checksum += st.checksum;
+    }
+    double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - begin).count();
+    
+    std::cout << "  " << std::left << std::setw(18) << name << std::right
+              << std::setw(12) << total.pushes
+              << std::setw(12) << total.decreaseKeys
+              << std::setw(12) << total.stalePops
+              << std::setw(12) << total.maxHeapSize
+              << std::setw(12) << std::fixed << std::setprecision(1) << ms
+              << "   (checksum " << std::setprecision(0) << total.checksum << ")\n";
+}
+
+void runSuite(const std::string& title, const sf::Graph& graph, int queries) {
+    sf::CompactGraph compact = graph.freeze();
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(compact.nodeCount()) - 1);
+    std::vector<int> sources;
+    for (int i = 0; i < queries; i++) {
+        sources.push_back(pick(rng));
+    }
+    
+    std::cout << title << " (" << compact.nodeCount() << " nodes, "
+              << compact.edgeCount() << " edges, " << queries << " sources)\n";
+    std::cout << "  " << std::left << std::setw(18) << "queue" << std::right
+              << std::setw(12) << "pushes" << std::setw(12) << "decrease"
+              << std::setw(12) << "stale pops" << std::setw(12) << "max heap"
+              << std::setw(12) << "ms" << "\n";
+    report("lazy binary", compact, sources, runLazy);
+    report("indexed 2-ary", compact, sources, runIndexed<2>);
+    report("indexed 4-ary", compact, sources, runIndexed<4>);
+    report("indexed 8-ary", compact, sources, runIndexed<8>);
+    std::cout << "\n";
+}
+
+void runPolicies(int side, int queries) {
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> weight(1, 9);
+    sf::Graph graph;
+    for (int i = 0; i < side * side; i++) {
+        graph.addNode(sf::Node(i, i % side, i / side));
+    }
+    for (int i = 0; i < side * side; i++) {
+        if (i % side + 1 < side) graph.addEdgeUndirected(i, i + 1, weight(rng));
+        if (i / side + 1 < side) graph.addEdgeUndirected(i, i + side, weight(rng));
+    }
+    sf::CompactGraph compact = graph.freeze();
+    
+    std::uniform_int_distribution<int> pick(0, side * side - 1);
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < queries; i++) {
+        pairs.emplace_back(pick(rng), pick(rng));
+    }
+    
+    std::cout << "Dijkstra::search queue policies, integer grid " << side << "x" << side
+              << " (" << queries << " queries)\n";
+    const std::pair<const char*, sf::QueuePolicy> policies[] = {
+        {"indexed 4-ary", sf::QueuePolicy::DaryHeap},
+        {"radix heap", sf::QueuePolicy::RadixHeap},
+        {"bucket queue", sf::QueuePolicy::BucketQueue},
+    };
+    sf::SearchWorkspace workspace;
+    for (const auto& policy : policies) {
+        double checksum = 0.0;
+        auto begin = std::chrono::steady_clock::now();
+        for (const auto& q : pairs) {
+            checksum += sf::Dijkstra::search(compact, q.first, q.second, workspace,
+                                             policy.second).cost;
+        }
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - begin).count();
+        std::cout << "  " << std::left << std::setw(18) << policy.first << std::right
+                  << std::setw(12) << std::fixed << std::setprecision(1) << ms << " ms"
+                  << "   (checksum " << std::setprecision(0) << checksum << ")\n";
+    }
+    std::cout << "\n";
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(42);
+    runSuite("Grid 300x300", makeGrid(300, rng), 10);
+    runSuite("Random digraph, out-degree 32", makeDense(20000, 32, rng), 10);
+    runPolicies(300, 50);
+    return 0;
+}
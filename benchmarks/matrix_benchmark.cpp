@@ -0,0 +1,82 @@
+// DistanceMatrix benchmark: a 300x300 cost matrix on a 150x150 grid computed
+// by point-to-point Dijkstra (a few rows, extrapolated), by one-to-many
+// Dijkstra with early termination, and by the contraction hierarchy bucket
+// method.
+#include "sf/path_planning.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace {
+
+sf::Graph makeGrid(int side, std::mt19937& rng) {
+    std::uniform_real_distribution<double> weight(1.0, 10.0);
+    sf::Graph graph;
+    for (int i = 0; i < side * side; i++) {
+        graph.addNode(sf::Node(i, i % side, i / side));
+    }
+    for (int i = 0; i < side * side; i++) {
+        if (i % side + 1 < side) graph.addEdgeUndirected(i, i + 1, weight(rng));
+        if (i / side + 1 < side) graph.addEdgeUndirected(i, i + side, weight(rng));
+    }
+    return graph;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+} // namespace
+
+int main() {
+    const int side = 150;
+    const size_t size = 300;
+    std::mt19937 rng(42);
+    sf::CompactGraph compact = makeGrid(side, rng).freeze();
+
+    std::uniform_int_distribution<int> pick(0, side * side - 1);
+    std::vector<int> sources;
+    std::vector<int> targets;
+    for (size_t i = 0; i < size; i++) {
+        sources.push_back(pick(rng));
+        targets.push_back(pick(rng));
+    }
+
+    std::cout << size << "x" << size << " matrix, grid " << side << "x" << side << "\n";
+    std::cout << std::fixed << std::setprecision(3);
+
+    const size_t sampleRows = 3;
+    auto begin = std::chrono::steady_clock::now();
+    double checksum = 0.0;
+    for (size_t i = 0; i < sampleRows; i++) {
+        for (int target : targets) {
+            checksum += sf::Dijkstra::search(compact, sources[i], target).cost;
+        }
+    }
+    double pointToPoint = secondsSince(begin) * size / sampleRows;
+    std::cout << "  point-to-point Dijkstra   " << std::setw(10) << pointToPoint
+              << " s (extrapolated)\n";
+
+    begin = std::chrono::steady_clock::now();
+    auto oneToMany = sf::DistanceMatrix<float>::compute(compact, sources, targets);
+    std::cout << "  one-to-many Dijkstra      " << std::setw(10) << secondsSince(begin) << " s\n";
+
+    begin = std::chrono::steady_clock::now();
+    sf::ContractionHierarchy ch(compact);
+    double build = secondsSince(begin);
+    begin = std::chrono::steady_clock::now();
+    auto buckets = sf::DistanceMatrix<float>::compute(ch, sources, targets);
+    std::cout << "  CH buckets                " << std::setw(10) << secondsSince(begin)
+              << " s (+ " << build << " s preprocessing)\n";
+
+    double maxError = 0.0;
+    for (size_t i = 0; i < size; i++) {
+        for (size_t j = 0; j < size; j++) {
+            maxError = std::max(maxError, std::abs(double(oneToMany(i, j)) - buckets(i, j)));
+        }
+    }
+    std::cout << "  max |one-to-many - CH|    " << std::setw(10) << maxError << "\n";
+    (void)checksum;
+    return 0;
+}
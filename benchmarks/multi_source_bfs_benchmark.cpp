@@ -0,0 +1,119 @@
+// Multi-source BFS benchmark: hop-count table from 256 depots, one sequential
+// BFS per depot (writing one table row each) versus MultiSourceBFS with 64-
+// and 256-wide batches, on a small-world random graph and on a 300x300 grid.
+#include "sf/path_planning.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace {
+
+sf::Graph makeGrid(int side) {
+    sf::Graph graph;
+    for (int i = 0; i < side * side; i++) {
+        graph.addNode(sf::Node(i, i % side, i / side));
+    }
+    for (int i = 0; i < side * side; i++) {
+        if (i % side + 1 < side) graph.addEdgeUndirected(i, i + 1, 1.0);
+        if (i / side + 1 < side) graph.addEdgeUndirected(i, i + side, 1.0);
+    }
+    return graph;
+}
+
+// Undirected random graph, average degree 8
+sf::Graph makeRandomGraph(int nodes, std::mt19937& rng) {
+    std::uniform_int_distribution<int> pick(0, nodes - 1);
+    sf::Graph graph;
+    for (int i = 0; i < nodes; i++) {
+        graph.addNode(sf::Node(i, i % 300, i / 300));
+    }
+    for (int i = 0; i < nodes; i++) {
+        for (int k = 0; k < 4; k++) {
+            graph.addEdgeUndirected(i, pick(rng), 1.0);
+        }
+    }
+    return graph;
+}
+
+// Sequential baseline: plain FIFO BFS per source over the CSR arrays
+long long bfsChecksum(const sf::CompactGraph& graph, const std::vector<int>& sources) {
+    const size_t n = graph.nodeCount();
+    std::vector<uint16_t> table(sources.size() * n, sf::HopTable::unreachable);
+    std::vector<int> queue;
+    for (size_t r = 0; r < sources.size(); r++) {
+        uint16_t* hops = table.data() + r * n;
+        queue.assign(1, graph.indexOf(sources[r]));
+        hops[queue[0]] = 0;
+        for (size_t i = 0; i < queue.size(); i++) {
+            int current = queue[i];
+            for (size_t e = graph.edgeBegin(current); e < graph.edgeEnd(current); e++) {
+                int next = graph.edgeTarget(e);
+                if (hops[next] == sf::HopTable::unreachable) {
+                    hops[next] = hops[current] + 1;
+                    queue.push_back(next);
+                }
+            }
+        }
+    }
+    long long checksum = 0;
+    for (uint16_t h : table) {
+        checksum += h;
+    }
+    return checksum;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+void benchmark(const std::string& name, const sf::CompactGraph& compact, size_t depots,
+               std::mt19937& rng) {
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(compact.nodeCount()) - 1);
+    std::vector<int> sources(depots);
+    for (int& s : sources) {
+        s = compact.idOf(pick(rng));
+    }
+
+    std::cout << "Hop table, " << depots << " depots, " << name << " ("
+              << sf::ThreadPool::defaultThreadCount() << " hardware threads)\n";
+
+    auto begin = std::chrono::steady_clock::now();
+    long long expected = bfsChecksum(compact, sources);
+    double baseline = secondsSince(begin);
+    std::cout << "  " << std::left << std::setw(20) << "BFS per depot" << std::right
+              << std::setw(10) << std::setprecision(3) << baseline << " s\n";
+
+    for (size_t width : {64, 256}) {
+        for (size_t threads : {1, 4}) {
+            sf::MultiSourceBFS msbfs(threads, width);
+            begin = std::chrono::steady_clock::now();
+            sf::HopTable table = msbfs.run(compact, sources);
+            double seconds = secondsSince(begin);
+
+            long long checksum = 0;
+            for (size_t c = 0; c < table.cols(); c++) {
+                const uint16_t* column = table.column(c);
+                for (size_t r = 0; r < table.rows(); r++) {
+                    checksum += column[r];
+                }
+            }
+            std::string label = "MS-BFS " + std::to_string(width) + " x" +
+                                std::to_string(threads);
+            std::cout << "  " << std::left << std::setw(20) << label << std::right
+                      << std::setw(10) << std::setprecision(3) << seconds << " s   speedup "
+                      << std::setprecision(2) << baseline / seconds
+                      << (checksum == expected ? "" : "   MISMATCH") << "\n";
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(42);
+    std::cout << std::fixed;
+    benchmark("random graph 90000 nodes", makeRandomGraph(90000, rng).freeze(), 256, rng);
+    benchmark("grid 300x300", makeGrid(300).freeze(), 256, rng);
+    return 0;
+}
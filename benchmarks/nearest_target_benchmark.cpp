@@ -0,0 +1,84 @@
+// Nearest-target benchmark: "which of 500 chargers is closest" on a 300x300
+// grid, answered by one A* per charger versus one MultiGoalSearch with the
+// zero, custom (linear min over goals) and euclidean (kd-tree) heuristics.
+#include "sf/path_planning.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+
+namespace {
+
+// Weights are at least the euclidean edge length, so the heuristic is admissible
+sf::Graph makeGrid(int side, std::mt19937& rng) {
+    std::uniform_real_distribution<double> weight(1.0, 3.0);
+    sf::Graph graph;
+    for (int i = 0; i < side * side; i++) {
+        graph.addNode(sf::Node(i, i % side, i / side));
+    }
+    for (int i = 0; i < side * side; i++) {
+        if (i % side + 1 < side) graph.addEdgeUndirected(i, i + 1, weight(rng));
+        if (i / side + 1 < side) graph.addEdgeUndirected(i, i + side, weight(rng));
+    }
+    return graph;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+} // namespace
+
+int main() {
+    const int side = 300;
+    const int chargers = 500;
+    const int queries = 20;
+    std::mt19937 rng(42);
+    sf::CompactGraph compact = makeGrid(side, rng).freeze();
+    std::uniform_int_distribution<int> anyNode(0, side * side - 1);
+    std::vector<int> goals;
+    for (int i = 0; i < chargers; i++) {
+        goals.push_back(anyNode(rng));
+    }
+    std::vector<int> starts;
+    for (int i = 0; i < queries; i++) {
+        starts.push_back(anyNode(rng));
+    }
+
+    std::cout << queries << " nearest-of-" << chargers << " queries, grid " << side << "x"
+              << side << "\n";
+    std::cout << std::fixed;
+    auto report = [](const char* name, double seconds, double checksum) {
+        std::cout << "  " << std::left << std::setw(28) << name << std::right << std::setw(10)
+                  << std::setprecision(4) << seconds << " s   checksum "
+                  << std::setprecision(3) << checksum << "\n";
+    };
+
+    auto begin = std::chrono::steady_clock::now();
+    double checksum = 0.0;
+    for (int start : starts) {
+        double best = std::numeric_limits<double>::infinity();
+        for (int goal : goals) {
+            best = std::min(best, sf::AStar::search(compact, start, goal).cost);
+        }
+        checksum += best;
+    }
+    report("A* per charger", secondsSince(begin), checksum);
+
+    auto custom = [](const sf::Node& a, const sf::Node& b) { return a.distance(b); };
+    const std::pair<const char*, sf::Heuristic> variants[] = {
+        {"multi-goal Dijkstra", sf::heuristics::zero},
+        {"multi-goal A* (linear min)", custom},
+        {"multi-goal A* (kd-tree)", sf::heuristics::euclidean},
+    };
+    for (const auto& [name, heuristic] : variants) {
+        begin = std::chrono::steady_clock::now();
+        checksum = 0.0;
+        for (int start : starts) {
+            checksum += sf::MultiGoalSearch::search(compact, start, goals, heuristic).result.cost;
+        }
+        report(name, secondsSince(begin), checksum);
+    }
+    return 0;
+}
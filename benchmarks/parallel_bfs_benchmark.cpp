@@ -0,0 +1,89 @@
+// Parallel BFS benchmark: hop distances from one source on a sparse random
+// digraph (average out-degree 16), a serial queue BFS versus ParallelBFS
+// top-down only and direction-optimizing with 1, 2, 4, 8 and 16 threads.
+#include "sf/path_planning.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace {
+
+sf::Graph makeRandomGraph(int nodes, int degree, std::mt19937& rng) {
+    std::uniform_int_distribution<int> pick(0, nodes - 1);
+    sf::Graph graph;
+    for (int i = 0; i < nodes; i++) {
+        graph.addNode(sf::Node(i, i % 1000, i / 1000));
+    }
+    for (int i = 0; i < nodes; i++) {
+        for (int k = 0; k < degree; k++) {
+            graph.addEdge(i, pick(rng), 1.0);
+        }
+    }
+    return graph;
+}
+
+// Sequential baseline: plain FIFO over the CSR arrays
+long long bfsChecksum(const sf::CompactGraph& graph, int source) {
+    std::vector<int> hops(graph.nodeCount(), -1);
+    std::vector<int> queue{source};
+    hops[source] = 0;
+    long long checksum = 0;
+    for (size_t i = 0; i < queue.size(); i++) {
+        int current = queue[i];
+        checksum += hops[current];
+        for (size_t e = graph.edgeBegin(current); e < graph.edgeEnd(current); e++) {
+            int next = graph.edgeTarget(e);
+            if (hops[next] < 0) {
+                hops[next] = hops[current] + 1;
+                queue.push_back(next);
+            }
+        }
+    }
+    return checksum;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+} // namespace
+
+int main() {
+    const int nodes = 1000000;
+    std::mt19937 rng(42);
+    sf::CompactGraph compact = makeRandomGraph(nodes, 16, rng).freeze();
+
+    std::cout << "Full BFS, random digraph " << nodes << " nodes, " << compact.edgeCount()
+              << " edges (" << sf::ThreadPool::defaultThreadCount() << " hardware threads)\n";
+    std::cout << std::fixed;
+
+    auto begin = std::chrono::steady_clock::now();
+    long long expected = bfsChecksum(compact, 0);
+    double baseline = secondsSince(begin);
+    std::cout << "  " << std::left << std::setw(20) << "BFS" << std::right
+              << std::setw(10) << std::setprecision(3) << baseline << " s\n";
+
+    auto report = [&](const std::string& name, size_t threads, double alpha) {
+        sf::ParallelBFS bfs(threads, alpha);
+        auto start = std::chrono::steady_clock::now();
+        sf::HopTree tree = bfs.run(compact, 0);
+        double seconds = secondsSince(start);
+
+        long long checksum = 0;
+        for (int h : tree.hops) {
+            checksum += h > 0 ? h : 0;
+        }
+        std::cout << "  " << std::left << std::setw(20) << (name + std::to_string(threads))
+                  << std::right << std::setw(10) << std::setprecision(3) << seconds
+                  << " s   speedup " << std::setprecision(2) << baseline / seconds
+                  << "   bottom-up " << tree.bottomUpLevels << "/" << tree.levels
+                  << (checksum == expected ? "" : "   MISMATCH") << "\n";
+    };
+
+    report("top-down x", 1, 0.0);
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        report("direction-opt x", threads, 15.0);
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+// Path tree cache benchmark: a fleet replanning from 8 depots to random goals
+// on a 300x300 grid, one Dijkstra per query versus one PathTreeCache.
+#include "sf/path_planning.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace {
+
+sf::Graph makeGrid(int side, std::mt19937& rng) {
+    std::uniform_real_distribution<double> weight(1.0, 3.0);
+    sf::Graph graph;
+    for (int i = 0; i < side * side; i++) {
+        graph.addNode(sf::Node(i, i % side, i / side));
+    }
+    for (int i = 0; i < side * side; i++) {
+        if (i % side + 1 < side) graph.addEdgeUndirected(i, i + 1, weight(rng));
+        if (i / side + 1 < side) graph.addEdgeUndirected(i, i + side, weight(rng));
+    }
+    return graph;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+} // namespace
+
+int main() {
+    const int side = 300;
+    const int depots = 8;
+    const int queries = 2000;
+    std::mt19937 rng(42);
+    sf::CompactGraph compact = makeGrid(side, rng).freeze();
+    std::uniform_int_distribution<int> anyNode(0, side * side - 1);
+    std::vector<int> depotIds;
+    for (int i = 0; i < depots; i++) {
+        depotIds.push_back(anyNode(rng));
+    }
+    std::vector<std::pair<int, int>> requests;
+    for (int i = 0; i < queries; i++) {
+        requests.emplace_back(depotIds[i % depots], anyNode(rng));
+    }
+
+    std::cout << queries << " queries from " << depots << " depots, grid " << side << "x"
+              << side << "\n";
+    std::cout << std::fixed;
+    auto report = [](const char* name, double seconds, double checksum) {
+        std::cout << "  " << std::left << std::setw(20) << name << std::right << std::setw(10)
+                  << std::setprecision(4) << seconds << " s   checksum "
+                  << std::setprecision(3) << checksum << "\n";
+    };
+
+    auto begin = std::chrono::steady_clock::now();
+    double checksum = 0.0;
+    for (const auto& [start, goal] : requests) {
+        checksum += sf::Dijkstra::search(compact, start, goal).cost;
+    }
+    report("Dijkstra per query", secondsSince(begin), checksum);
+
+    sf::PathTreeCache cache;
+    begin = std::chrono::steady_clock::now();
+    checksum = 0.0;
+    for (const auto& [start, goal] : requests) {
+        checksum += cache.search(compact, start, goal).cost;
+    }
+    report("PathTreeCache", secondsSince(begin), checksum);
+
+    sf::PathTreeCacheStats stats = cache.stats();
+    std::cout << "  hits " << stats.hits << ", resumed " << stats.resumed << ", misses "
+              << stats.misses << ", hit rate " << std::setprecision(3) << stats.hitRate()
+              << ", " << stats.bytes / 1024 << " KiB cached\n";
+    return 0;
+}
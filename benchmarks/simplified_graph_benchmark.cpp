@@ -0,0 +1,97 @@
+// Chain contraction benchmark: a 60x60 street grid whose streets are
+// polylines of 8 nodes, answered by A* on the original graph versus
+// SimplifiedGraph::search on the contracted one.
+#include "sf/path_planning.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace {
+
+sf::Graph makeStreets(int side, int polyline, std::mt19937& rng) {
+    std::uniform_real_distribution<double> stretch(1.0, 1.5);
+    sf::Graph graph;
+    const double spacing = polyline + 1;
+    for (int i = 0; i < side * side; i++) {
+        graph.addNode(sf::Node(i, (i % side) * spacing, (i / side) * spacing));
+    }
+    int next = side * side;
+    auto street = [&](int a, int b) {
+        const sf::Node from = graph.getNode(a);
+        const sf::Node to = graph.getNode(b);
+        int prev = a;
+        for (int k = 1; k <= polyline + 1; k++) {
+            int id = b;
+            if (k <= polyline) {
+                id = next++;
+                double t = static_cast<double>(k) / (polyline + 1);
+                graph.addNode(sf::Node(id, from.x + (to.x - from.x) * t,
+                                       from.y + (to.y - from.y) * t));
+            }
+            graph.addEdgeUndirected(prev, id, stretch(rng));
+            prev = id;
+        }
+    };
+    for (int i = 0; i < side * side; i++) {
+        if (i % side + 1 < side) street(i, i + 1);
+        if (i / side + 1 < side) street(i, i + side);
+    }
+    return graph;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+} // namespace
+
+int main() {
+    const int side = 60;
+    const int queries = 200;
+    std::mt19937 rng(42);
+    sf::Graph graph = makeStreets(side, 8, rng);
+    sf::CompactGraph compact = graph.freeze();
+
+    auto begin = std::chrono::steady_clock::now();
+    sf::SimplifiedGraph simplified(graph);
+    double buildSeconds = secondsSince(begin);
+
+    std::vector<int> ids = graph.getNodeIds();
+    std::uniform_int_distribution<size_t> anyNode(0, ids.size() - 1);
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < queries; i++) {
+        pairs.emplace_back(ids[anyNode(rng)], ids[anyNode(rng)]);
+    }
+
+    std::cout << queries << " queries, " << graph.nodeCount() << " nodes reduced to "
+              << simplified.graph().nodeCount() << " (" << simplified.chainCount()
+              << " chains, built in " << std::fixed << std::setprecision(4) << buildSeconds
+              << " s)\n";
+    auto report = [](const char* name, double seconds, double checksum, size_t explored) {
+        std::cout << "  " << std::left << std::setw(20) << name << std::right << std::setw(10)
+                  << std::setprecision(4) << seconds << " s   expanded " << std::setw(9)
+                  << explored << "   checksum " << std::setprecision(3) << checksum << "\n";
+    };
+
+    begin = std::chrono::steady_clock::now();
+    double checksum = 0.0;
+    size_t explored = 0;
+    for (const auto& [start, goal] : pairs) {
+        auto r = sf::AStar::search(compact, start, goal);
+        checksum += r.cost;
+        explored += r.nodesExplored;
+    }
+    report("A* original", secondsSince(begin), checksum, explored);
+
+    begin = std::chrono::steady_clock::now();
+    checksum = 0.0;
+    explored = 0;
+    for (const auto& [start, goal] : pairs) {
+        auto r = simplified.search(start, goal);
+        checksum += r.cost;
+        explored += r.nodesExplored;
+    }
+    report("A* simplified", secondsSince(begin), checksum, explored);
+    return 0;
+}
@@ -0,0 +1,141 @@
+// Concurrent read / write benchmark: reader threads run A* queries over a
+// 500x500 grid while one writer streams traffic weight updates, published in
+// batches. Query latency is reported with no writer, with VersionedGraph
+// snapshots, and with a Graph behind a shared_mutex (readers share the lock,
+// the writer takes it exclusively per batch).
+#include "sf/path_planning.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+
+namespace {
+
+const int side = 500;
+const int readers = 4;
+const int batch = 500;
+const auto phase = std::chrono::milliseconds(1500);
+
+double microsecondsSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin)
+        .count();
+}
+
+// Query pairs about 60 cells apart, so one A* takes well under a millisecond
+std::pair<int, int> randomQuery(std::mt19937& rng) {
+    std::uniform_int_distribution<int> coordinate(0, side - 61);
+    int x = coordinate(rng);
+    int y = coordinate(rng);
+    return {y * side + x, (y + 40) * side + x + 40};
+}
+
+// Runs query() on every reader and write() on the writer (if any) for one
+// phase; prints reader latency percentiles and the writer's update rate
+template <typename Query, typename Write>
+void runPhase(const char* name, Query query, Write write, bool withWriter) {
+    std::atomic<bool> stop(false);
+    std::vector<std::vector<double>> latencies(readers);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < readers; t++) {
+        threads.emplace_back([&, t]() {
+            std::mt19937 rng(t + 1);
+            sf::SearchWorkspace workspace;
+            while (!stop) {
+                auto [start, goal] = randomQuery(rng);
+                auto begin = std::chrono::steady_clock::now();
+                query(start, goal, workspace);
+                latencies[t].push_back(microsecondsSince(begin));
+            }
+        });
+    }
+    size_t updates = 0;
+    std::thread writer([&]() {
+        std::mt19937 rng(99);
+        while (withWriter && !stop) {
+            write(rng);
+            updates += batch;
+        }
+    });
+    std::this_thread::sleep_for(phase);
+    stop = true;
+    writer.join();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<double> all;
+    for (const auto& list : latencies) {
+        all.insert(all.end(), list.begin(), list.end());
+    }
+    std::sort(all.begin(), all.end());
+    auto percentile = [&](double p) { return all[static_cast<size_t>(p * (all.size() - 1))]; };
+    std::cout << "  " << std::left << std::setw(26) << name << std::right << std::fixed
+              << std::setprecision(0) << std::setw(8) << all.size() << " queries  p50 "
+              << std::setw(5) << percentile(0.5) << " us  p99 " << std::setw(6)
+              << percentile(0.99) << " us  max " << std::setw(7) << all.back() << " us  "
+              << std::setw(8) << updates / (phase.count() / 1000.0) << " updates/s\n";
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> weight(1.0, 3.0);
+    sf::Graph graph;
+    for (int i = 0; i < side * side; i++) {
+        graph.addNode(sf::Node(i, i % side, i / side));
+    }
+    std::vector<sf::EdgeHandle> handles;
+    for (int i = 0; i < side * side; i++) {
+        if (i % side + 1 < side) {
+            auto pair = graph.addEdgeUndirected(i, i + 1, weight(rng));
+            handles.push_back(pair.first);
+            handles.push_back(pair.second);
+        }
+        if (i / side + 1 < side) {
+            auto pair = graph.addEdgeUndirected(i, i + side, weight(rng));
+            handles.push_back(pair.first);
+            handles.push_back(pair.second);
+        }
+    }
+    std::cout << "grid " << side << "x" << side << ", " << readers << " reader threads, "
+              << batch << " updates per publish\n";
+
+    sf::VersionedGraph versioned(graph);
+    auto snapshotQuery = [&](int start, int goal, sf::SearchWorkspace& workspace) {
+        sf::GraphSnapshot snapshot = versioned.snapshot();
+        snapshot.search(start, goal, sf::heuristics::euclidean, workspace);
+    };
+    auto snapshotWrite = [&](std::mt19937& writerRng) {
+        std::uniform_int_distribution<int> cell(0, side * side - 2);
+        for (int k = 0; k < batch; k++) {
+            int from = cell(writerRng);
+            int to = from % side + 1 < side ? from + 1 : from - 1;
+            versioned.setEdgeWeight(from, to, weight(writerRng));
+        }
+        versioned.publish();
+    };
+    runPhase("VersionedGraph, no writer", snapshotQuery, snapshotWrite, false);
+    runPhase("VersionedGraph + writer", snapshotQuery, snapshotWrite, true);
+
+    std::shared_mutex mutex;
+    auto lockedQuery = [&](int start, int goal, sf::SearchWorkspace&) {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        sf::AStar::search(graph, start, goal);
+    };
+    auto lockedWrite = [&](std::mt19937& writerRng) {
+        std::uniform_int_distribution<size_t> pick(0, handles.size() - 1);
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        for (int k = 0; k < batch; k++) {
+            graph.setEdgeWeight(handles[pick(writerRng)], weight(writerRng));
+        }
+    };
+    runPhase("locked Graph, no writer", lockedQuery, lockedWrite, false);
+    runPhase("locked Graph + writer", lockedQuery, lockedWrite, true);
+    return 0;
+}
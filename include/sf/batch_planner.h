@@ -0,0 +1,86 @@
+#pragma once
+
+#include "graph.h"
+#include "compact_graph.h"
+#include "search_workspace.h"
+#include "thread_pool.h"
+#include <memory>
+#include <vector>
+
+namespace sf {
+
+// Search algorithm of a batched query
+enum class PlanAlgorithm {
+    BFS,
+    DFS,
+    Dijkstra,
+    BestFirst,
+    AStar,
+    BidirectionalDijkstra,
+    BidirectionalAStar
+};
+
+// One point-to-point query
+struct PlanRequest {
+    int startId;
+    int goalId;
+    PlanAlgorithm algorithm;
+
+    PlanRequest(int start = -1, int goal = -1, PlanAlgorithm algorithm = PlanAlgorithm::AStar)
+        : startId(start), goalId(goal), algorithm(algorithm) {}
+};
+
+// Per-batch statistics
+struct BatchStats {
+    size_t queries = 0;
+    size_t found = 0;
+    size_t nodesExplored = 0;   // summed over all queries
+    size_t threads = 0;
+    double seconds = 0.0;       // wall-clock time of the batch
+    double queriesPerSecond = 0.0;
+};
+
+// Runs batches of independent queries on a work-stealing thread pool
+//
+// The graph is shared read-only by all workers. Each worker owns a pair of
+// SearchWorkspaces that is reused across queries and batches, so a warmed-up
+// planner performs no allocation beyond the returned paths. Results are
+// written to a caller-provided array in request order.
+class BatchPlanner {
+public:
+    // The CompactGraph must outlive the planner
+    explicit BatchPlanner(const CompactGraph& graph, size_t threads = 0,
+                          Heuristic heuristic = heuristics::euclidean);
+    // Freezes and keeps a private snapshot of graph
+    explicit BatchPlanner(const Graph& graph, size_t threads = 0,
+                          Heuristic heuristic = heuristics::euclidean);
+
+    BatchPlanner(const BatchPlanner&) = delete;
+    BatchPlanner& operator=(const BatchPlanner&) = delete;
+
+    // Solve requests[0..count) into results[0..count)
+    BatchStats run(const PlanRequest* requests, size_t count, PathResult* results);
+    // results is resized to requests.size()
+    BatchStats run(const std::vector<PlanRequest>& requests, std::vector<PathResult>& results);
+
+    size_t threads() const { return pool.size(); }
+    const CompactGraph& graph() const { return *compact; }
+
+private:
+    struct alignas(64) Scratch {
+        SearchWorkspace forward;
+        SearchWorkspace backward;
+        size_t found = 0;
+        size_t nodesExplored = 0;
+    };
+
+    std::unique_ptr<CompactGraph> owned;
+    const CompactGraph* compact;
+    Heuristic heuristic;
+    ThreadPool pool;
+    std::vector<Scratch> scratch;
+
+    PathResult solve(const PlanRequest& request, Scratch& local) const;
+};
+
+} // namespace sf
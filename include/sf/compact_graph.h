@@ -0,0 +1,81 @@
+#pragma once
+
+#include "graph.h"
+#include "reachability.h"
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+namespace sf {
+
+// Frozen compressed-sparse-row (CSR) snapshot of a Graph
+//
+// Nodes are renumbered into a dense 0..N-1 range (in ascending id order) and
+// the outgoing edges of node i are stored contiguously in
+// [edgeBegin(i), edgeEnd(i)). Searches take and return the original node ids;
+// the dense indices are only used internally. Incoming edges are indexed too
+// (reverse CSR) so backward searches work on directed graphs.
+class CompactGraph {
+private:
+    std::vector<int> ids;                // dense index -> original id
+    std::unordered_map<int, int> index;  // original id -> dense index
+    std::vector<double> xs;
+    std::vector<double> ys;
+    std::vector<size_t> offsets;         // nodeCount() + 1 entries
+    std::vector<int> targets;            // dense target index per edge
+    std::vector<double> weights;
+    std::vector<size_t> inOffsets;       // reverse CSR over incoming edges
+    std::vector<int> inSources;          // dense source index per incoming edge
+    std::vector<size_t> inEdges;         // forward edge index per incoming edge
+    double maxWeight = 0.0;
+    double weightScale = 0.0;
+    uint64_t snapshotVersion = 0;
+    ReachabilityIndex reach;
+
+public:
+    CompactGraph() = default;
+    explicit CompactGraph(const Graph& graph);
+
+    size_t nodeCount() const { return ids.size(); }
+    size_t edgeCount() const { return targets.size(); }
+
+    bool hasNode(int id) const;
+
+    // Dense index of an original node id, or -1 if the node does not exist
+    int indexOf(int id) const;
+    int idOf(int index) const { return ids[index]; }
+
+    double x(int index) const { return xs[index]; }
+    double y(int index) const { return ys[index]; }
+    Node node(int index) const { return Node(ids[index], xs[index], ys[index]); }
+
+    size_t edgeBegin(int index) const { return offsets[index]; }
+    size_t edgeEnd(int index) const { return offsets[index + 1]; }
+    int edgeTarget(size_t edge) const { return targets[edge]; }
+    double edgeWeight(size_t edge) const { return weights[edge]; }
+
+    // Incoming edges of node index in [reverseBegin(i), reverseEnd(i))
+    size_t reverseBegin(int index) const { return inOffsets[index]; }
+    size_t reverseEnd(int index) const { return inOffsets[index + 1]; }
+    int reverseSource(size_t inEdge) const { return inSources[inEdge]; }
+    size_t reverseEdge(size_t inEdge) const { return inEdges[inEdge]; }
+    double reverseWeight(size_t inEdge) const { return weights[inEdges[inEdge]]; }
+
+    // False only if no path between the dense indices can exist; weak and
+    // strong components are indexed when the snapshot is built
+    bool mayReach(int from, int to) const { return reach.mayReach(from, to); }
+    const ReachabilityIndex& reachability() const { return reach; }
+
+    double maxEdgeWeight() const { return maxWeight; }
+
+    // Process-wide unique stamp of this snapshot (0 for an empty default
+    // graph); copies share it. Caches key derived data by it.
+    uint64_t version() const { return snapshotVersion; }
+
+    // Smallest power of two s (up to 2^16) such that every weight * s is a
+    // non-negative integer, or 0 if the weights are not fixed-point. Used to
+    // select integer priority queues (see priority_queues.h).
+    double integerWeightScale() const { return weightScale; }
+};
+
+} // namespace sf
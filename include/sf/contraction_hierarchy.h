@@ -0,0 +1,89 @@
+#pragma once
+
+#include "graph.h"
+#include "compact_graph.h"
+#include "search_workspace.h"
+#include <utility>
+#include <vector>
+
+namespace sf {
+
+// Preprocessing parameters for ContractionHierarchy
+struct ContractionOptions {
+    size_t threads = 0;                // worker threads, 0 = hardware concurrency
+    size_t witnessSettleLimit = 500;   // nodes a witness search may settle
+};
+
+// Contraction Hierarchies (CH)
+//
+// Preprocessing contracts nodes in order of increasing priority (edge
+// difference plus the number of already contracted neighbours). Contracting v
+// inserts a shortcut u -> w for every pair of neighbours whose shortest path
+// runs through v, unless a bounded witness search finds an equally short path
+// around it. Each round contracts every node whose (priority, id) is smallest
+// within its 2-hop neighbourhood; their shortcuts and the neighbours' new
+// priorities are computed on a thread pool, and the result does not depend
+// on the thread count.
+//
+// Queries run a bidirectional Dijkstra that only follows edges towards
+// higher-ranked nodes (with stall-on-demand) and unpack shortcuts back into
+// original node ids, so results match Dijkstra::search.
+class ContractionHierarchy {
+public:
+    ContractionHierarchy() = default;
+    explicit ContractionHierarchy(const Graph& graph,
+                                  const ContractionOptions& options = ContractionOptions());
+    explicit ContractionHierarchy(const CompactGraph& graph,
+                                  const ContractionOptions& options = ContractionOptions());
+
+    PathResult search(int startId, int goalId) const;
+    PathResult search(int startId, int goalId,
+                      SearchWorkspace& forward, SearchWorkspace& backward) const;
+
+    // Many-to-many shortest-path costs with the bucket method: one backward
+    // upward search per target fills per-node buckets, then one forward upward
+    // search per source scans them. Searches of each phase run in parallel.
+    // Row-major sourceIds.size() x targetIds.size(); infinity if unreachable
+    // or unknown.
+    std::vector<double> distanceTable(const std::vector<int>& sourceIds,
+                                      const std::vector<int>& targetIds,
+                                      size_t threads = 0) const;
+
+    size_t nodeCount() const { return base.nodeCount(); }
+    size_t shortcutCount() const { return shortcuts; }
+
+    // Contraction order of a node (0 = contracted first), or -1 if unknown
+    int rank(int id) const;
+
+    // Dense node numbering shared with the CompactGraph the hierarchy was built from
+    const CompactGraph& graph() const { return base; }
+
+private:
+    struct Arc {
+        int node;      // dense index of the other endpoint
+        double weight;
+        int middle;    // contracted node this shortcut bypasses, -1 for an original edge
+    };
+
+    CompactGraph base;
+    std::vector<int> ranks;
+    size_t shortcuts = 0;
+
+    // Upward graph in CSR form. up[v]: arcs v -> w with rank(w) > rank(v).
+    // down[v]: arcs w -> v with rank(w) > rank(v), stored as (w, weight).
+    std::vector<size_t> upOffsets;
+    std::vector<Arc> upArcs;
+    std::vector<size_t> downOffsets;
+    std::vector<Arc> downArcs;
+
+    void build(const ContractionOptions& options);
+    const Arc* findUp(int from, int to) const;
+    const Arc* findDown(int from, int to) const;
+    void unpack(int from, int to, int middle, std::vector<int>& path) const;
+    // Exhaustive upward search (forward over up arcs, else over down arcs)
+    // with stall-on-demand; appends every non-stalled settled node
+    void upwardSearch(int source, bool forward, SearchWorkspace& workspace,
+                      std::vector<std::pair<int, double>>& settled) const;
+};
+
+} // namespace sf
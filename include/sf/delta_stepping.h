@@ -0,0 +1,82 @@
+#pragma once
+
+#include "graph.h"
+#include "compact_graph.h"
+#include "thread_pool.h"
+#include <vector>
+
+namespace sf {
+
+// Full single-source shortest-path result
+//
+// Arrays are indexed by position in ids (ascending node ids, the same dense
+// numbering as CompactGraph).
+struct ShortestPathTree {
+    int sourceId = -1;
+    std::vector<int> ids;
+    std::vector<double> distance;   // infinity if unreachable
+    std::vector<int> parent;        // parent node id, -1 for the source and unreached nodes
+    size_t nodesExplored = 0;
+
+    bool reached(int id) const;
+    // Cost from the source, infinity if unreachable or unknown
+    double distanceTo(int id) const;
+    // Node ids source .. id, empty if unreachable
+    std::vector<int> pathTo(int id) const;
+};
+
+// Parallel delta-stepping SSSP (Meyer & Sanders)
+//
+// Tentative distances are kept in buckets of width delta. All nodes of the
+// current bucket are expanded at once: light edges (weight <= delta) are
+// relaxed repeatedly until the bucket stays empty, then heavy edges once for
+// every node settled in it. Nodes are partitioned into one contiguous block
+// per thread; workers turn their share of the frontier into relaxation
+// requests, and each block owner applies the requests for its own nodes, so
+// no atomics are needed. delta = 0 picks maxEdgeWeight / average out-degree.
+// Buckets are reused cyclically, ceil(maxEdgeWeight / delta) + 2 per block,
+// however far the distances reach.
+class DeltaStepping {
+public:
+    explicit DeltaStepping(size_t threads = 0, double delta = 0.0);
+
+    DeltaStepping(const DeltaStepping&) = delete;
+    DeltaStepping& operator=(const DeltaStepping&) = delete;
+
+    // Distances and parents for every node
+    ShortestPathTree run(const CompactGraph& graph, int sourceId);
+    // Freezes the graph for this call; freeze once and reuse for many queries
+    ShortestPathTree run(const Graph& graph, int sourceId);
+
+    // Stops once the goal's bucket is settled
+    PathResult search(const CompactGraph& graph, int startId, int goalId);
+    // Freezes the graph for this call; freeze once and reuse for many queries
+    PathResult search(const Graph& graph, int startId, int goalId);
+
+    size_t threads() const { return pool.size(); }
+    // Bucket width that run()/search() use for graph
+    double bucketWidth(const CompactGraph& graph) const;
+
+private:
+    struct Request {
+        int node;
+        int parent;
+        double dist;
+    };
+
+    // Per-thread block of nodes and its buckets
+    struct Owner {
+        std::vector<std::vector<int>> buckets;   // ring: bucket i in slot i % size
+        std::vector<int> frontier;
+        std::vector<int> settled;
+    };
+
+    ThreadPool pool;
+    double delta;
+
+    // Dense distances / parents; stops after the goal's bucket if goal >= 0
+    size_t solve(const CompactGraph& graph, int source, int goal,
+                 std::vector<double>& dist, std::vector<int>& parent);
+};
+
+} // namespace sf
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "graph.h"
+#include "compact_graph.h"
+#include "contraction_hierarchy.h"
+#include <limits>
+#include <vector>
+
+namespace sf {
+
+// Dense row-major matrix of shortest-path costs between two node sets
+//
+// Entry (i, j) is the cost from sources[i] to targets[j], or infinity if the
+// target is unreachable or either id is unknown. T is float or double.
+template <typename T>
+class DistanceMatrix {
+public:
+    DistanceMatrix() = default;
+    DistanceMatrix(size_t rows, size_t cols)
+        : rowCount(rows), colCount(cols),
+          values(rows * cols, std::numeric_limits<T>::infinity()) {}
+
+    // One Dijkstra per source (rows in parallel), each stopping as soon as
+    // every target is settled
+    static DistanceMatrix compute(const CompactGraph& graph, const std::vector<int>& sources,
+                                  const std::vector<int>& targets, size_t threads = 0);
+    // Freezes the graph for this call; freeze once and reuse for many queries
+    static DistanceMatrix compute(const Graph& graph, const std::vector<int>& sources,
+                                  const std::vector<int>& targets, size_t threads = 0);
+    // Bucket-based many-to-many on a contraction hierarchy: cost grows with
+    // rows + cols upward searches rather than rows full Dijkstra trees
+    static DistanceMatrix compute(const ContractionHierarchy& hierarchy,
+                                  const std::vector<int>& sources,
+                                  const std::vector<int>& targets, size_t threads = 0);
+
+    size_t rows() const { return rowCount; }
+    size_t cols() const { return colCount; }
+
+    T operator()(size_t row, size_t col) const { return values[row * colCount + col]; }
+    T& operator()(size_t row, size_t col) { return values[row * colCount + col]; }
+
+    const T* row(size_t r) const { return values.data() + r * colCount; }
+    T* row(size_t r) { return values.data() + r * colCount; }
+    const T* data() const { return values.data(); }
+
+private:
+    size_t rowCount = 0;
+    size_t colCount = 0;
+    std::vector<T> values;
+};
+
+extern template class DistanceMatrix<float>;
+extern template class DistanceMatrix<double>;
+
+} // namespace sf
@@ -1,24 +1,55 @@
 #pragma once
 
 #include "graph.h"
+#include "compact_graph.h"
+#include "indexed_heap.h"
+#include <cstdint>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace sf {
 
+namespace dynamic_internal {
+
+// Graph a persistent planner runs on, with the planner's private edge costs
+//
+// Built from a CompactGraph, which must outlive the table, or from a Graph,
+// which is frozen into a private snapshot. Costs start at the graph's
+// weights. Unknown ids and missing edges throw, naming the owning planner.
+class EdgeCostTable {
+public:
+    EdgeCostTable(const CompactGraph& graph, const char* owner);
+    EdgeCostTable(const Graph& graph, const char* owner);
+
+    const CompactGraph& graph() const { return *compact; }
+    // Dense index of an original node id
+    int indexOf(int id) const;
+
+    // Current cost of a CSR edge
+    double operator[](size_t e) const { return costs[e]; }
+    // Cheapest from -> to cost between dense indices, infinity if none
+    double cheapest(int from, int to) const;
+    // Set every from -> to edge and return the cheapest cost it replaced;
+    // throws if there is none
+    double set(int from, int to, double weight);
+
+private:
+    std::unique_ptr<CompactGraph> owned;
+    const CompactGraph* compact;
+    const char* owner;
+    std::vector<double> costs;     // current weight per CSR edge
+};
+
+} // namespace dynamic_internal
+
 // 3.1 D* (Dynamic A*)
+//
+// One-shot entry points; they plan from scratch with a DStarPlanner, update()
+// with the removed edges blocked. Keep a DStarPlanner to replan incrementally.
 class DStar {
-private:
-    struct State {
-        double g;
-        double rhs;
-        bool visited;
-        
-        State() : g(std::numeric_limits<double>::infinity()), 
-                  rhs(std::numeric_limits<double>::infinity()), 
-                  visited(false) {}
-    };
-    
 public:
     static PathResult search(const Graph& graph, int startId, int goalId,
                             Heuristic heuristic = heuristics::euclidean);
@@ -29,39 +60,213 @@ public:
                             Heuristic heuristic = heuristics::euclidean);
 };
 
+// 3.1.1 Persistent D* planner (Stentz)
+//
+// Searches backwards from the goal and keeps, per node, the cost to the goal
+// h, the backpointer edge towards the goal and a NEW / OPEN / CLOSED tag,
+// with the open list keyed by the smallest h the node had since it was
+// queued. After an edge cost changes, its target is re-queued; RAISE states
+// (key below h) push the increase to the nodes whose backpointers lead
+// through them and LOWER states (key equal to h) pull in cheaper routes, and
+// plan() stops as soon as the open list's key reaches h(start). Only the
+// region whose cost to the goal changed is expanded. D* needs no heuristic;
+// DStarLitePlanner is the heuristic-focused alternative.
+class DStarPlanner {
+public:
+    // Graph ownership and errors as for dynamic_internal::EdgeCostTable
+    DStarPlanner(const CompactGraph& graph, int startId, int goalId);
+    DStarPlanner(const Graph& graph, int startId, int goalId);
+
+    DStarPlanner(const DStarPlanner&) = delete;
+    DStarPlanner& operator=(const DStarPlanner&) = delete;
+
+    // Propagate pending cost changes up to the current start and follow the
+    // backpointers; nodesExplored counts the states processed by this call
+    PathResult plan();
+
+    void moveStart(int startId);
+    // Set the cost of every from -> to edge; throws if there is none
+    void updateEdgeCost(int fromId, int toId, double weight);
+    // Same as updateEdgeCost with an infinite weight
+    void removeEdge(int fromId, int toId);
+    // Cheapest from -> to cost, infinity if there is no such edge
+    double edgeCost(int fromId, int toId) const;
+
+    int start() const { return compact->idOf(startIndex); }
+    int goal() const { return compact->idOf(goalIndex); }
+    // States processed over the planner's lifetime
+    size_t expansions() const { return totalExpanded; }
+
+private:
+    enum class Tag : uint8_t { New, Open, Closed };
+
+    static constexpr size_t kNoEdge = static_cast<size_t>(-1);
+
+    dynamic_internal::EdgeCostTable costs;
+    const CompactGraph* compact;
+    std::vector<double> h;         // cost to the goal along the backpointers
+    std::vector<size_t> next;      // backpointer: CSR edge towards the goal
+    std::vector<Tag> tags;
+    IndexedDaryHeap<4> open;       // keyed by k, the smallest h while queued
+    int startIndex = -1;
+    int goalIndex = -1;
+    size_t totalExpanded = 0;
+
+    void initialize(int startId, int goalId);
+    void insert(int node, double newH);
+    void processState();
+};
+
 // 3.2 D* Lite
+//
+// One-shot entry points; they plan from scratch with a DStarLitePlanner,
+// update() with the changed edges blocked. Keep a DStarLitePlanner to replan
+// incrementally.
 class DStarLite {
 public:
     static PathResult search(const Graph& graph, int startId, int goalId,
                             Heuristic heuristic = heuristics::euclidean);
     
-    // Update for dynamic environment
+    // Plan with every listed from -> to edge blocked (infinite cost); pairs
+    // without an edge are ignored
     static PathResult update(const Graph& graph, int startId, int goalId,
                             const std::vector<std::pair<int, int>>& changedEdges,
                             Heuristic heuristic = heuristics::euclidean);
 };
 
+// 3.2.1 Persistent D* Lite planner (Koenig & Likhachev, optimized version)
+//
+// Searches backwards from the goal and keeps g / rhs values and the open list
+// between calls, so plan() after moveStart() or updateEdgeCost() only
+// re-expands the vertices made inconsistent by the change. The start may move
+// along the path: the key modifier km grows by h(previous start, new start)
+// instead of re-keying the queue. Edge costs are private to the planner and
+// may be set to infinity to block an edge. The heuristic must be consistent.
+class DStarLitePlanner {
+public:
+    // Graph ownership and errors as for dynamic_internal::EdgeCostTable
+    DStarLitePlanner(const CompactGraph& graph, int startId, int goalId,
+                     Heuristic heuristic = heuristics::euclidean);
+    DStarLitePlanner(const Graph& graph, int startId, int goalId,
+                     Heuristic heuristic = heuristics::euclidean);
+
+    DStarLitePlanner(const DStarLitePlanner&) = delete;
+    DStarLitePlanner& operator=(const DStarLitePlanner&) = delete;
+
+    // Bring the affected vertices up to date and return the path from the
+    // current start; nodesExplored counts the vertices expanded by this call
+    PathResult plan();
+
+    void moveStart(int startId);
+    // Set the cost of every from -> to edge; throws if there is none
+    void updateEdgeCost(int fromId, int toId, double weight);
+    // Cheapest from -> to cost, infinity if there is no such edge
+    double edgeCost(int fromId, int toId) const;
+
+    int start() const { return compact->idOf(startIndex); }
+    int goal() const { return compact->idOf(goalIndex); }
+    // Vertices expanded over the planner's lifetime
+    size_t expansions() const { return totalExpanded; }
+
+private:
+    using Key = std::pair<double, double>;
+
+    dynamic_internal::EdgeCostTable costs;
+    const CompactGraph* compact;
+    Heuristic heuristic;
+    std::vector<double> g;
+    std::vector<double> rhs;
+    IndexedDaryHeap<4, Key> open;
+    int startIndex = -1;
+    int goalIndex = -1;
+    double km = 0.0;
+    size_t totalExpanded = 0;
+
+    void initialize(int startId, int goalId);
+    double h(int from, int to) const;
+    Key calculateKey(int node) const;
+    // rhs from the successors' g values
+    double lookahead(int node) const;
+    void updateVertex(int node);
+    size_t computeShortestPath();
+};
+
 // 3.3 LPA* (Lifelong Planning A*)
+//
+// One-shot entry points; they plan from scratch with an LPAStarPlanner,
+// update() with the changed nodes blocked. Keep an LPAStarPlanner to replan
+// incrementally.
 class LPAStar {
-private:
-    struct State {
-        double g;
-        double rhs;
-        double h;
-        
-        State() : g(std::numeric_limits<double>::infinity()),
-                  rhs(std::numeric_limits<double>::infinity()),
-                  h(0.0) {}
-    };
-    
 public:
     static PathResult search(const Graph& graph, int startId, int goalId,
                             Heuristic heuristic = heuristics::euclidean);
     
-    // Update for dynamic changes
+    // Search with every listed node blocked, as by
+    // LPAStarPlanner::notifyNodeBlocked; unknown ids are ignored, and a
+    // blocked start or goal leaves no path
     static PathResult update(const Graph& graph, int startId, int goalId,
                             const std::vector<int>& changedNodes,
                             Heuristic heuristic = heuristics::euclidean);
 };
 
+// 3.3.1 Persistent LPA* planner
+//
+// Forward LPA* between a fixed start and goal. g / rhs values, the open list
+// keyed by (min(g, rhs) + h, min(g, rhs)) and per-node heuristic values
+// (computed on first use) survive between calls, so computeShortestPath()
+// after a notification only re-expands vertices whose rhs changed. Edge costs
+// are private to the planner. Blocking a node sets its edges to infinity;
+// unblocking restores each edge to its last notified cost (the graph's weight
+// if none) unless its other end is still blocked. The heuristic must be
+// consistent.
+class LPAStarPlanner {
+public:
+    // Graph ownership and errors as for dynamic_internal::EdgeCostTable
+    LPAStarPlanner(const CompactGraph& graph, int startId, int goalId,
+                   Heuristic heuristic = heuristics::euclidean);
+    LPAStarPlanner(const Graph& graph, int startId, int goalId,
+                   Heuristic heuristic = heuristics::euclidean);
+
+    LPAStarPlanner(const LPAStarPlanner&) = delete;
+    LPAStarPlanner& operator=(const LPAStarPlanner&) = delete;
+
+    // Repair the inconsistent vertices and return the start -> goal path;
+    // nodesExplored counts the vertices expanded by this call
+    PathResult computeShortestPath();
+
+    // Set the cost of every from -> to edge; throws if there is none
+    void notifyEdgeChanged(int fromId, int toId, double weight);
+    // Block (or restore) every edge into and out of a node
+    void notifyNodeBlocked(int id, bool block = true);
+    // Cheapest from -> to cost, infinity if there is no such edge
+    double edgeCost(int fromId, int toId) const;
+
+    int start() const { return compact->idOf(startIndex); }
+    int goal() const { return compact->idOf(goalIndex); }
+    // Vertices expanded over the planner's lifetime
+    size_t expansions() const { return totalExpanded; }
+
+private:
+    using Key = std::pair<double, double>;
+
+    dynamic_internal::EdgeCostTable costs;  // last notified weights
+    const CompactGraph* compact;
+    Heuristic heuristic;
+    std::vector<bool> blocked;
+    std::vector<double> g;
+    std::vector<double> rhs;
+    std::vector<double> hCache;    // NaN until first needed
+    IndexedDaryHeap<4, Key> open;
+    int startIndex = -1;
+    int goalIndex = -1;
+    size_t totalExpanded = 0;
+
+    void initialize(int startId, int goalId);
+    double h(int node);
+    Key calculateKey(int node);
+    // Notified cost of edge e from -> to, infinity while either end is blocked
+    double cost(int from, size_t e, int to) const;
+    void updateVertex(int node);
+};
+
 } // namespace sf
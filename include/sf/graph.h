@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -8,6 +9,8 @@
 #include <limits>
 #include <cmath>
 #include <functional>
+#include <utility>
+#include "reachability.h"
 
 namespace sf {
 
@@ -29,24 +32,95 @@ struct Node {
     }
 };
 
+// Stable edge handle returned by Graph::addEdge; -1 for none
+using EdgeHandle = int;
+
 // Edge structure
 struct Edge {
     int from, to;
     double weight;
+    EdgeHandle handle;
+    
+    Edge(int f, int t, double w, EdgeHandle h = -1) : from(f), to(t), weight(w), handle(h) {}
+};
+
+// One entry of Graph's change log; version is the graph version the change
+// produced. Removals and re-weights carry the edge's previous weight.
+struct GraphChange {
+    enum class Type : uint8_t {
+        NodeAdded,
+        EdgeAdded,
+        EdgeRemoved,
+        WeightChanged,
+        NodeBlocked,
+        NodeUnblocked,
+        Cleared
+    };
     
-    Edge(int f, int t, double w) : from(f), to(t), weight(w) {}
+    uint64_t version;
+    Type type;
+    int from;           // node id for the node changes
+    int to;
+    EdgeHandle edge;
+    double oldWeight;
+    double weight;
 };
 
+class CompactGraph;
+
 // Graph class
+//
+// Edges are addressed by the handle addEdge returns. Handles stay valid until
+// the edge is removed and are not reused before clear(), so setEdgeWeight /
+// removeEdge / blockNode run in O(1): removal swaps the last edge of the list
+// into the gap, so neighbour order is not preserved. Every mutation bumps
+// version(); with recordChanges() on, each one also appends a GraphChange
+// that planners and caches can read back with changesSince().
 class Graph {
 private:
+    // Where a handle's edge lives: adjacency (or parked, while from is
+    // blocked) of from at index position; position -1 once removed
+    struct EdgeLocation {
+        int from;
+        int position;
+    };
+    
     std::unordered_map<int, Node> nodes;
     std::unordered_map<int, std::vector<Edge>> adjacency;
+    std::unordered_map<int, std::vector<Edge>> parked;  // out-edges of blocked nodes
+    std::vector<EdgeLocation> locations;                 // by handle
+    std::unordered_map<int, int> slots;  // node id -> slot in reach
+    ReachabilityIndex reach;
+    uint64_t currentVersion = 0;
+    bool logging = false;
+    uint64_t logStart = 0;               // log holds the versions after this
+    std::vector<GraphChange> log;
+    
+    Edge& edgeAt(EdgeHandle handle);
+    void record(GraphChange::Type type, int from, int to, EdgeHandle edge,
+                double oldWeight, double weight);
     
 public:
     void addNode(const Node& node);
-    void addEdge(int from, int to, double weight);
-    void addEdgeUndirected(int from, int to, double weight);
+    EdgeHandle addEdge(int from, int to, double weight);
+    // Handles of the from -> to and to -> from edges
+    std::pair<EdgeHandle, EdgeHandle> addEdgeUndirected(int from, int to, double weight);
+    
+    // O(1) by handle; unknown or removed handles throw
+    const Edge& getEdge(EdgeHandle handle) const;
+    bool hasEdge(EdgeHandle handle) const;
+    void setEdgeWeight(EdgeHandle handle, double weight);
+    void removeEdge(EdgeHandle handle);
+    // First from -> to edge, -1 if there is none; O(out-degree of from)
+    EdgeHandle findEdge(int from, int to) const;
+    
+    // Block (or restore) a node in O(1), as an obstacle: its outgoing edges
+    // are parked, and searches and freeze() skip the edges into it, so no
+    // path passes through or ends at it. getNeighbors of other nodes still
+    // lists those edges; parked edges keep their handles and can still be
+    // re-weighted.
+    void blockNode(int id, bool blocked = true);
+    bool isBlocked(int id) const;
     
     const Node& getNode(int id) const;
     const std::vector<Edge>& getNeighbors(int id) const;
@@ -54,10 +128,33 @@ public:
     
     bool hasNode(int id) const;
     size_t nodeCount() const;
+    // Traversable edges: neither parked by blockNode nor into a blocked node
     size_t edgeCount() const;
     
     std::vector<int> getNodeIds() const;
     
+    // False only if no path from -> to can exist (see reachability.h). Weak
+    // components are kept current by addEdge; strong components only after
+    // indexReachability() and until an edge breaks their order.
+    bool mayReach(int fromId, int toId) const;
+    void indexReachability();
+    const ReachabilityIndex& reachability() const { return reach; }
+    
+    // Dense CSR snapshot for query-heavy workloads (see compact_graph.h)
+    CompactGraph freeze() const;
+    
+    // Bumped by every mutation, including clear(); never decreases
+    uint64_t version() const { return currentVersion; }
+    
+    // Start (or stop and drop) the change log at the current version
+    void recordChanges(bool enabled = true);
+    bool recordingChanges() const { return logging; }
+    // Changes with version > since, oldest first; throws if the log does not
+    // reach back that far (not recording, or trimmed)
+    std::vector<GraphChange> changesSince(uint64_t since) const;
+    // Drop the entries with version <= upTo once every consumer has them
+    void trimChanges(uint64_t upTo);
+    
     void clear();
 };
 
@@ -74,6 +171,13 @@ struct PathResult {
         : found(true), path(p), cost(c), nodesExplored(n) {}
 };
 
+// State of a search that runs in slices
+enum class SearchStatus {
+    Running,
+    Found,
+    Failed
+};
+
 // Heuristic function type
 using Heuristic = std::function<double(const Node&, const Node&)>;
 
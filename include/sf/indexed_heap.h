@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace sf {
+
+// Indexed d-ary min-heap over dense integer ids
+//
+// Each id appears at most once; its slot is tracked so that decrease-key,
+// arbitrary key updates and removal run in O(log_d n) without leaving stale
+// entries behind. Items are stored as contiguous (key, id) pairs, and a 4- or
+// 8-ary layout keeps all children of a node in one or two cache lines.
+template <unsigned Arity = 4, typename Key = double, typename Compare = std::less<Key>>
+class IndexedDaryHeap {
+    static_assert(Arity >= 2, "heap arity must be at least 2");
+
+private:
+    struct Item {
+        Key key;
+        int id;
+    };
+
+    std::vector<Item> items;
+    std::vector<int> positions;  // id -> slot in items, -1 if absent
+    Compare less;
+
+    void place(size_t slot, const Item& item) {
+        items[slot] = item;
+        positions[item.id] = static_cast<int>(slot);
+    }
+
+    void siftUp(size_t slot) {
+        Item item = items[slot];
+        while (slot > 0) {
+            size_t parent = (slot - 1) / Arity;
+            if (!less(item.key, items[parent].key)) {
+                break;
+            }
+            place(slot, items[parent]);
+            slot = parent;
+        }
+        place(slot, item);
+    }
+
+    void siftDown(size_t slot) {
+        Item item = items[slot];
+        const size_t n = items.size();
+        while (true) {
+            size_t first = slot * Arity + 1;
+            if (first >= n) {
+                break;
+            }
+            size_t last = first + Arity < n ? first + Arity : n;
+            size_t best = first;
+            for (size_t c = first + 1; c < last; c++) {
+                if (less(items[c].key, items[best].key)) {
+                    best = c;
+                }
+            }
+            if (!less(items[best].key, item.key)) {
+                break;
+            }
+            place(slot, items[best]);
+            slot = best;
+        }
+        place(slot, item);
+    }
+
+public:
+    explicit IndexedDaryHeap(size_t idCount = 0) : positions(idCount, -1) {}
+
+    // Allow ids in [0, idCount); existing entries are kept
+    void resize(size_t idCount) {
+        if (positions.size() < idCount) {
+            positions.resize(idCount, -1);
+        }
+    }
+
+    bool empty() const { return items.empty(); }
+    size_t size() const { return items.size(); }
+
+    // Bytes held by the item and position arrays
+    size_t memoryUsage() const {
+        return items.capacity() * sizeof(Item) + positions.capacity() * sizeof(int);
+    }
+
+    bool contains(int id) const {
+        return static_cast<size_t>(id) < positions.size() && positions[id] >= 0;
+    }
+
+    int top() const { return items.front().id; }
+    const Key& topKey() const { return items.front().key; }
+    const Key& key(int id) const { return items[positions[id]].key; }
+
+    // id must not already be in the heap
+    void push(int id, const Key& key) {
+        items.push_back(Item{key, id});
+        positions[id] = static_cast<int>(items.size() - 1);
+        siftUp(items.size() - 1);
+    }
+
+    // new key must not be larger than the current one
+    void decreaseKey(int id, const Key& key) {
+        size_t slot = positions[id];
+        items[slot].key = key;
+        siftUp(slot);
+    }
+
+    // Change the key of a queued id in either direction
+    void update(int id, const Key& key) {
+        size_t slot = positions[id];
+        bool up = less(key, items[slot].key);
+        items[slot].key = key;
+        if (up) {
+            siftUp(slot);
+        } else {
+            siftDown(slot);
+        }
+    }
+
+    // Insert, or lower the key if id is queued with a larger one.
+    // Returns false when id was already queued with a key that is not larger.
+    bool pushOrDecrease(int id, const Key& key) {
+        if (!contains(id)) {
+            push(id, key);
+            return true;
+        }
+        if (less(key, items[positions[id]].key)) {
+            decreaseKey(id, key);
+            return true;
+        }
+        return false;
+    }
+
+    // Insert or move id to key, whichever applies
+    void pushOrUpdate(int id, const Key& key) {
+        if (contains(id)) {
+            update(id, key);
+        } else {
+            push(id, key);
+        }
+    }
+
+    int pop() {
+        int id = items.front().id;
+        remove(id);
+        return id;
+    }
+
+    void remove(int id) {
+        size_t slot = positions[id];
+        positions[id] = -1;
+        Item last = items.back();
+        items.pop_back();
+        if (slot == items.size()) {
+            return;
+        }
+        items[slot] = last;
+        positions[last.id] = static_cast<int>(slot);
+        if (slot > 0 && less(last.key, items[(slot - 1) / Arity].key)) {
+            siftUp(slot);
+        } else {
+            siftDown(slot);
+        }
+    }
+
+    // O(size()): only the queued ids need their slot reset
+    void clear() {
+        for (const Item& item : items) {
+            positions[item.id] = -1;
+        }
+        items.clear();
+    }
+};
+
+} // namespace sf
@@ -1,6 +1,12 @@
 #pragma once
 
 #include "graph.h"
+#include "compact_graph.h"
+#include "search_workspace.h"
+#include "priority_queues.h"
+#include "thread_pool.h"
+#include <chrono>
+#include <functional>
 #include <queue>
 
 namespace sf {
@@ -10,6 +16,10 @@ class BestFirstSearch {
 public:
     static PathResult search(const Graph& graph, int startId, int goalId, 
                             Heuristic heuristic = heuristics::euclidean);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId,
+                            Heuristic heuristic = heuristics::euclidean);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId,
+                            Heuristic heuristic, SearchWorkspace& workspace);
 };
 
 // 2.2 A* Algorithm
@@ -17,13 +27,129 @@ class AStar {
 public:
     static PathResult search(const Graph& graph, int startId, int goalId,
                             Heuristic heuristic = heuristics::euclidean);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId,
+                            Heuristic heuristic = heuristics::euclidean);
+    // Integer queues key nodes by g + floor(h); they assume a consistent heuristic
+    static PathResult search(const CompactGraph& graph, int startId, int goalId,
+                            Heuristic heuristic, SearchWorkspace& workspace,
+                            QueuePolicy queue = QueuePolicy::Auto);
+};
+
+// 2.2.1 Weighted A*
+// Priority g + weight * h. With an admissible heuristic and weight >= 1 the
+// path costs at most weight times the optimum, usually after far fewer
+// expansions. The weight is folded into the inlined heuristic functor.
+class WeightedAStar {
+public:
+    static PathResult search(const Graph& graph, int startId, int goalId, double weight,
+                            Heuristic heuristic = heuristics::euclidean);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId, double weight,
+                            Heuristic heuristic = heuristics::euclidean);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId, double weight,
+                            Heuristic heuristic, SearchWorkspace& workspace);
+};
+
+// 2.2.2 ARA* (Anytime Repairing A*)
+// Runs weighted A* with a falling inflation epsilon and reuses the search
+// state between iterations: only nodes whose cost improved after they were
+// expanded (the INCONS set) are reopened. Every iteration that reaches the
+// goal reports its path and suboptimality bound
+// min(epsilon, cost / min over open nodes of (g + h)), which needs an
+// admissible heuristic. The search stops at the deadline, checked every 64
+// expansions, or once the bound reaches 1.
+struct ARAStarOptions {
+    using Clock = std::chrono::steady_clock;
+
+    double initialEpsilon = 3.0;
+    double epsilonStep = 0.5;   // epsilon decrease per iteration, floored at 1
+    Clock::time_point deadline = Clock::time_point::max();
+    // Called with each improved path and its suboptimality bound
+    std::function<void(const PathResult& result, double bound)> onSolution;
+};
+
+class ARAStar {
+public:
+    // Best path found by the deadline (nodesExplored sums all iterations);
+    // not found if even the first iteration did not finish. Freezes the graph
+    // for this call; freeze once and reuse for many queries
+    static PathResult search(const Graph& graph, int startId, int goalId,
+                            const ARAStarOptions& options,
+                            Heuristic heuristic = heuristics::euclidean);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId,
+                            const ARAStarOptions& options,
+                            Heuristic heuristic = heuristics::euclidean);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId,
+                            const ARAStarOptions& options, Heuristic heuristic,
+                            SearchWorkspace& workspace);
 };
 
 // 2.3 IDA* (Iterative Deepening A*)
+// Depth-first iterations with an explicit stack, each bounded by the
+// smallest f that exceeded the previous bound. Memory is the current path
+// plus a fixed-size transposition table that prunes nodes re-entered within
+// an iteration without a smaller g. The tables belong to the calling thread
+// and are reused, without clearing, by its later searches.
+struct IDAStarOptions {
+    size_t tableEntries = size_t(1) << 16;   // rounded up to a power of two, 0 disables
+    size_t threads = 1;                      // 0 selects the hardware concurrency
+};
+
 class IDAStar {
 public:
+    // Freezes the graph for this call; freeze once and reuse for many queries
+    static PathResult search(const Graph& graph, int startId, int goalId,
+                            Heuristic heuristic = heuristics::euclidean);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId,
+                            Heuristic heuristic = heuristics::euclidean);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId,
+                            Heuristic heuristic, SearchWorkspace& workspace);
+    // With threads > 1 this starts a ParallelIDAStar for the call; keep one
+    // to reuse its pool and workspaces across queries
+    static PathResult search(const CompactGraph& graph, int startId, int goalId,
+                            const IDAStarOptions& options,
+                            Heuristic heuristic = heuristics::euclidean);
+};
+
+// 2.3.1 Parallel IDA*
+// Every iteration splits the top of the tree breadth-first into independent
+// subtrees for the pool, one workspace per worker. Any path found within the
+// bound is optimal, but which of several equal-cost paths is returned may
+// vary between runs.
+class ParallelIDAStar {
+public:
+    explicit ParallelIDAStar(size_t threads = 0, size_t tableEntries = size_t(1) << 16);
+
+    ParallelIDAStar(const ParallelIDAStar&) = delete;
+    ParallelIDAStar& operator=(const ParallelIDAStar&) = delete;
+
+    PathResult search(const CompactGraph& graph, int startId, int goalId,
+                      Heuristic heuristic = heuristics::euclidean);
+    // Freezes the graph for this call; freeze once and reuse for many queries
+    PathResult search(const Graph& graph, int startId, int goalId,
+                      Heuristic heuristic = heuristics::euclidean);
+
+    size_t threads() const { return pool.size(); }
+
+private:
+    ThreadPool pool;
+    size_t tableEntries;
+    std::vector<SearchWorkspace> workspaces;
+};
+
+// 2.4 Bidirectional A*
+// Bidirectional search with the average potential
+// pf(v) = (h(v, goal) - h(start, v)) / 2, which is consistent for both
+// directions when the heuristic is consistent and symmetric.
+class BidirectionalAStar {
+public:
+    // Freezes the graph for this call; freeze once and reuse for many queries
     static PathResult search(const Graph& graph, int startId, int goalId,
                             Heuristic heuristic = heuristics::euclidean);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId,
+                            Heuristic heuristic = heuristics::euclidean);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId,
+                            Heuristic heuristic,
+                            SearchWorkspace& forward, SearchWorkspace& backward);
 };
 
 } // namespace sf
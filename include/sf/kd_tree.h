@@ -0,0 +1,38 @@
+#pragma once
+
+#include "graph.h"
+#include <vector>
+
+namespace sf {
+
+// Static 2-d tree over a set of points for nearest-point queries
+//
+// Points are kept in one array in implicit tree order (median split,
+// alternating x / y), so the tree needs no pointers and building it is
+// O(n log n). Coordinates and ids are taken from the Node values.
+class KdTree {
+public:
+    enum class Metric {
+        Euclidean,
+        Manhattan
+    };
+
+    KdTree() = default;
+    explicit KdTree(std::vector<Node> points);
+
+    size_t size() const { return points.size(); }
+    bool empty() const { return points.empty(); }
+
+    // Nearest point to (x, y) under metric, nullptr if the tree is empty;
+    // distance receives its distance
+    const Node* nearest(double x, double y, Metric metric, double& distance) const;
+
+private:
+    std::vector<Node> points;
+
+    void build(size_t begin, size_t end, int axis);
+    void search(size_t begin, size_t end, int axis, double x, double y, Metric metric,
+                const Node*& best, double& bestDistance) const;
+};
+
+} // namespace sf
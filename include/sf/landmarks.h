@@ -0,0 +1,86 @@
+#pragma once
+
+#include "graph.h"
+#include "compact_graph.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace sf {
+
+// How Landmarks picks its landmark nodes
+enum class LandmarkSelection {
+    Farthest,  // repeatedly take the node farthest from all landmarks so far
+    Avoid      // Goldberg-Werneck "avoid": grow landmarks into badly covered regions
+};
+
+// Preprocessing parameters for Landmarks
+struct LandmarkOptions {
+    size_t count = 16;                                  // number of landmarks
+    LandmarkSelection selection = LandmarkSelection::Farthest;
+    size_t threads = 0;                                 // 0 = hardware concurrency
+    uint32_t seed = 1;                                  // first landmark / avoid roots
+};
+
+// ALT (A*, Landmarks, Triangle inequality) lower bounds
+//
+// For every landmark L the distances d(L, v) and d(v, L) to all nodes are
+// precomputed, one Dijkstra per landmark and direction run in parallel. By the
+// triangle inequality
+//     d(u, t) >= max_L max(d(L, t) - d(L, u), d(u, L) - d(t, L)),
+// which is a consistent heuristic that is usually much tighter than euclidean
+// distance on graphs with detours.
+//
+// Tables are stored node-major as float32 (8 bytes per node and landmark).
+// Distances that fit a float exactly (e.g. integer weights) keep exact, fully
+// consistent bounds. Otherwise values are rounded towards zero and the
+// subtracted term is widened by the float rounding error, so bounds stay
+// admissible and are consistent up to that rounding error. Bounds hold as
+// long as edge weights do not decrease, so the heuristic also suits D* /
+// D* Lite / LPA* when edges are only blocked or made more expensive.
+class Landmarks {
+public:
+    Landmarks() = default;
+    explicit Landmarks(const Graph& graph, const LandmarkOptions& options = LandmarkOptions());
+    explicit Landmarks(const CompactGraph& graph,
+                       const LandmarkOptions& options = LandmarkOptions());
+    // Use the given landmark ids instead of selecting them (unknown ids are skipped)
+    Landmarks(const CompactGraph& graph, const std::vector<int>& landmarkIds,
+              size_t threads = 0);
+
+    size_t count() const { return tables ? tables->count : 0; }
+    const std::vector<int>& landmarkIds() const;
+
+    // Lower bound on the shortest-path cost fromId -> toId (0 if unknown)
+    double lowerBound(int fromId, int toId) const;
+
+    // Heuristic for AStar, IDAStar, BidirectionalAStar and the dynamic
+    // planners. It shares the tables, so it stays valid after this object is
+    // destroyed.
+    Heuristic heuristic() const;
+
+    // Bytes held by the distance tables
+    size_t memoryBytes() const;
+
+private:
+    struct Tables {
+        size_t count = 0;
+        std::vector<int> landmarks;          // original ids
+        std::unordered_map<int, int> index;  // original id -> dense index
+        std::vector<float> forward;          // d(L, v) at [v * count + L]
+        std::vector<float> backward;         // d(v, L) at [v * count + L]
+        double slack = 1.0;                  // widening of subtracted terms
+
+        double bound(int from, int to) const;
+    };
+
+    std::shared_ptr<const Tables> tables;
+
+    // landmarks are dense indices; the first `filled` forward columns are
+    // already computed (exact: without rounding)
+    void build(const CompactGraph& graph, std::vector<int> landmarks,
+               std::vector<float> forward, size_t filled, bool exact, size_t threads);
+};
+
+} // namespace sf
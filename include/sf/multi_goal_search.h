@@ -0,0 +1,58 @@
+#pragma once
+
+#include "graph.h"
+#include "compact_graph.h"
+#include "search_workspace.h"
+#include <vector>
+
+namespace sf {
+
+// A start for a multi-source query; offset is the cost already incurred
+// before leaving it (e.g. an agent still on its way to that node)
+struct SearchStart {
+    int id;
+    double offset = 0.0;
+};
+
+struct MultiGoalResult {
+    // Path from startId to goalId; cost includes the start's offset
+    PathResult result;
+    int startId = -1;
+    int goalId = -1;   // -1 when no goal is reachable
+};
+
+// 2.2.3 Nearest-target search
+//
+// Searches from one or more starts towards a set of goals and stops as soon
+// as the first goal is settled, which is the goal (and start) with the
+// cheapest offset + path cost. The A* heuristic is the minimum of the given
+// heuristic over all goals, which stays admissible and consistent whenever
+// the per-goal heuristic is. For the built-in euclidean and manhattan
+// heuristics the minimum comes from a kd-tree over the goal coordinates, so
+// each evaluation costs O(log goals) instead of O(goals); heuristics::zero
+// gives plain multi-source Dijkstra. Unknown start and goal ids are ignored.
+class MultiGoalSearch {
+public:
+    // The Graph overloads freeze the graph for each call; freeze once and
+    // reuse for many queries
+    static MultiGoalResult search(const Graph& graph, int startId,
+                                  const std::vector<int>& goalIds,
+                                  Heuristic heuristic = heuristics::euclidean);
+    static MultiGoalResult search(const Graph& graph, const std::vector<SearchStart>& starts,
+                                  const std::vector<int>& goalIds,
+                                  Heuristic heuristic = heuristics::euclidean);
+
+    static MultiGoalResult search(const CompactGraph& graph, int startId,
+                                  const std::vector<int>& goalIds,
+                                  Heuristic heuristic = heuristics::euclidean);
+    static MultiGoalResult search(const CompactGraph& graph,
+                                  const std::vector<SearchStart>& starts,
+                                  const std::vector<int>& goalIds,
+                                  Heuristic heuristic = heuristics::euclidean);
+    static MultiGoalResult search(const CompactGraph& graph,
+                                  const std::vector<SearchStart>& starts,
+                                  const std::vector<int>& goalIds, Heuristic heuristic,
+                                  SearchWorkspace& workspace);
+};
+
+} // namespace sf
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "graph.h"
+#include "compact_graph.h"
+#include "thread_pool.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace sf {
+
+// Hop counts from a list of sources to every node
+//
+// Columns are dense node indices (ascending node ids, the same numbering as
+// CompactGraph). Entries are 16-bit and stored column-major, so the counts
+// from all sources to one node are adjacent; unreachable pairs hold
+// `unreachable`.
+class HopTable {
+public:
+    static constexpr uint16_t unreachable = 0xFFFF;
+
+    HopTable() = default;
+    HopTable(std::vector<int> sourceIds, std::vector<int> ids)
+        : sources(std::move(sourceIds)), columnIds(std::move(ids)),
+          values(sources.size() * columnIds.size(), unreachable) {}
+
+    size_t rows() const { return sources.size(); }
+    size_t cols() const { return columnIds.size(); }
+    const std::vector<int>& sourceIds() const { return sources; }
+    const std::vector<int>& ids() const { return columnIds; }
+
+    uint16_t operator()(size_t row, size_t col) const { return values[col * rows() + row]; }
+    // rows() entries: hops from every source to node col
+    const uint16_t* column(size_t col) const { return values.data() + col * rows(); }
+    uint16_t* column(size_t col) { return values.data() + col * rows(); }
+
+    // Hops from sourceIds()[row] to node id, -1 if unreachable or unknown
+    int hopsTo(size_t row, int id) const;
+    size_t memoryBytes() const { return values.size() * sizeof(uint16_t); }
+
+private:
+    std::vector<int> sources;
+    std::vector<int> columnIds;
+    std::vector<uint16_t> values;
+};
+
+// Bit-parallel multi-source BFS (MS-BFS, Then et al.)
+//
+// Sources are packed batchWidth (64, 128 or 256) to a pass: every node keeps
+// one bit per source of the batch for "seen" and one for "on the frontier",
+// so a single traversal advances all searches of the batch and each edge is
+// scanned once per level for all of them. The gain grows with how much the
+// searches overlap: large on small-diameter graphs, little on long grids
+// where the frontiers of distant sources rarely meet. Passes are independent
+// and run in parallel on the pool. Throws std::runtime_error if a hop count
+// does not fit the 16-bit table.
+class MultiSourceBFS {
+public:
+    explicit MultiSourceBFS(size_t threads = 0, size_t batchWidth = 256);
+
+    MultiSourceBFS(const MultiSourceBFS&) = delete;
+    MultiSourceBFS& operator=(const MultiSourceBFS&) = delete;
+
+    HopTable run(const CompactGraph& graph, const std::vector<int>& sourceIds);
+    // Freezes the graph for this call; freeze once and reuse for many queries
+    HopTable run(const Graph& graph, const std::vector<int>& sourceIds);
+
+    size_t threads() const { return pool.size(); }
+    size_t batchWidth() const { return width; }
+
+private:
+    // Per-worker traversal state (batchWidth / 64 words per node), reused
+    // across passes
+    struct Scratch {
+        std::vector<uint64_t> seen;
+        std::vector<uint64_t> visit;
+        std::vector<uint64_t> visitNext;
+        std::vector<int> frontier;
+        std::vector<int> next;
+    };
+
+    ThreadPool pool;
+    size_t width;
+
+    // Fill rows [first, first + count) of table
+    void pass(const CompactGraph& graph, HopTable& table, size_t first, size_t count,
+              Scratch& scratch);
+};
+
+} // namespace sf
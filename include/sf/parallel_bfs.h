@@ -0,0 +1,69 @@
+#pragma once
+
+#include "graph.h"
+#include "compact_graph.h"
+#include "thread_pool.h"
+#include <cstdint>
+#include <vector>
+
+namespace sf {
+
+// Hop distances from one source to every node
+//
+// Arrays are indexed by position in ids (ascending node ids, the same dense
+// numbering as CompactGraph).
+struct HopTree {
+    int sourceId = -1;
+    std::vector<int> ids;
+    std::vector<int> hops;      // -1 if unreachable
+    std::vector<int> parent;    // parent node id, -1 for the source and unreached nodes
+    size_t reached = 0;         // nodes with hops >= 0
+    size_t levels = 0;          // BFS levels expanded
+    size_t bottomUpLevels = 0;  // of which ran bottom-up
+
+    // Hop count from the source, -1 if unreachable or unknown
+    int hopsTo(int id) const;
+    // Node ids source .. id, empty if unreachable
+    std::vector<int> pathTo(int id) const;
+};
+
+// Direction-optimizing parallel BFS (Beamer et al.)
+//
+// Small frontiers expand top-down: workers scan the out-edges of their share
+// of the frontier and claim unvisited targets in a dense atomic visited
+// bitset. Once the frontier's out-edges exceed the unexplored edges / alpha,
+// levels switch to bottom-up: every unvisited node scans its in-edges for a
+// parent in the frontier bitmap, and each worker owns whole 64-node words so
+// bits are written without atomics. Search returns to top-down when the
+// frontier shrinks below nodeCount / beta. alpha = 0 disables bottom-up.
+class ParallelBFS {
+public:
+    explicit ParallelBFS(size_t threads = 0, double alpha = 15.0, double beta = 18.0);
+
+    ParallelBFS(const ParallelBFS&) = delete;
+    ParallelBFS& operator=(const ParallelBFS&) = delete;
+
+    // Hop distances and parents for the whole reachable set
+    HopTree run(const CompactGraph& graph, int sourceId);
+    // Freezes the graph for this call; freeze once and reuse for many queries
+    HopTree run(const Graph& graph, int sourceId);
+
+    // Fewest-hop path; stops after the level that reaches the goal
+    PathResult search(const CompactGraph& graph, int startId, int goalId);
+    // Freezes the graph for this call; freeze once and reuse for many queries
+    PathResult search(const Graph& graph, int startId, int goalId);
+
+    size_t threads() const { return pool.size(); }
+
+private:
+    ThreadPool pool;
+    double alpha;
+    double beta;
+
+    // Dense hops / parents; returns nodes visited. Stops after the goal's
+    // level if goal >= 0.
+    size_t solve(const CompactGraph& graph, int source, int goal, std::vector<int>& hops,
+                 std::vector<int>& parent, size_t& levels, size_t& bottomUpLevels);
+};
+
+} // namespace sf
@@ -4,10 +4,30 @@
 // Include all algorithms in one convenient header
 
 #include "graph.h"
+#include "compact_graph.h"
+#include "indexed_heap.h"
+#include "priority_queues.h"
+#include "search_workspace.h"
+#include "search_engine.h"
 #include "uninformed_search.h"
 #include "informed_search.h"
 #include "dynamic_search.h"
 #include "sampling_based.h"
+#include "thread_pool.h"
+#include "contraction_hierarchy.h"
+#include "landmarks.h"
+#include "batch_planner.h"
+#include "distance_matrix.h"
+#include "delta_stepping.h"
+#include "parallel_bfs.h"
+#include "multi_source_bfs.h"
+#include "resumable_search.h"
+#include "kd_tree.h"
+#include "multi_goal_search.h"
+#include "path_tree_cache.h"
+#include "reachability.h"
+#include "simplified_graph.h"
+#include "versioned_graph.h"
 
 namespace sf {
 
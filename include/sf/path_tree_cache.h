@@ -0,0 +1,98 @@
+#pragma once
+
+#include "graph.h"
+#include "compact_graph.h"
+#include "search_workspace.h"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace sf {
+
+// Counters of a PathTreeCache
+struct PathTreeCacheStats {
+    size_t hits = 0;        // goal already settled (or tree exhausted): no expansion
+    size_t resumed = 0;     // cached tree grown until the goal was settled
+    size_t misses = 0;      // new tree started
+    size_t evictions = 0;
+    size_t trees = 0;       // trees currently cached
+    size_t bytes = 0;       // memory held by the cached trees
+
+    size_t queries() const { return hits + resumed + misses; }
+    // Fraction of queries that reused a cached tree (hits and resumes)
+    double hitRate() const {
+        return queries() == 0 ? 0.0 : static_cast<double>(hits + resumed) / queries();
+    }
+};
+
+// LRU cache of partially grown Dijkstra shortest-path trees
+//
+// Trees are keyed by (source, CompactGraph::version()), so a new snapshot of
+// the graph never sees stale distances. A query whose goal is already settled
+// in the cached tree is answered by walking parent links; otherwise the
+// stored open list is resumed until the goal is settled, so repeated queries
+// from one source together cost at most one full Dijkstra. Each tree keeps a
+// SearchWorkspace of its own, and trees are evicted least recently used first
+// once their memory exceeds the budget.
+//
+// All methods are thread-safe. Queries from different sources run in
+// parallel; queries from the same source take turns on its tree.
+class PathTreeCache {
+public:
+    explicit PathTreeCache(size_t memoryBudget = size_t(256) << 20);
+
+    PathTreeCache(const PathTreeCache&) = delete;
+    PathTreeCache& operator=(const PathTreeCache&) = delete;
+
+    // Same result as Dijkstra::search; nodesExplored counts only the nodes
+    // settled by this call
+    PathResult search(const CompactGraph& graph, int startId, int goalId);
+
+    // Drop every tree (counters are kept)
+    void clear();
+    PathTreeCacheStats stats() const;
+
+    size_t memoryBudget() const { return budget; }
+
+private:
+    struct Key {
+        int source;
+        uint64_t version;
+
+        bool operator==(const Key& other) const {
+            return source == other.source && version == other.version;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return std::hash<uint64_t>()(key.version * 0x9E3779B97F4A7C15ull ^
+                                         static_cast<uint32_t>(key.source));
+        }
+    };
+
+    // One partially grown tree; mutex guards the other members
+    struct Tree {
+        std::mutex mutex;
+        SearchWorkspace workspace;
+        bool started = false;
+    };
+
+    struct Slot {
+        std::shared_ptr<Tree> tree;
+        std::list<Key>::iterator recent;
+        size_t bytes = 0;
+    };
+
+    const size_t budget;
+    mutable std::mutex mutex;  // guards everything below
+    std::unordered_map<Key, Slot, KeyHash> slots;
+    std::list<Key> recency;    // most recently used first
+    PathTreeCacheStats counters;
+
+    void evictOverBudget();
+};
+
+} // namespace sf
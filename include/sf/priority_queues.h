@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace sf {
+
+class CompactGraph;
+
+// Open-list implementation used by Dijkstra / A* on a CompactGraph
+enum class QueuePolicy {
+    Auto,         // pick from the edge weights (see resolveQueuePolicy)
+    DaryHeap,     // indexed 4-ary heap with decrease-key, any weights
+    RadixHeap,    // monotone radix heap, integral or fixed-point weights
+    BucketQueue   // Dial bucket queue, small integral or fixed-point weights
+};
+
+// Turn Auto into a concrete policy for this graph. Integer queues are chosen
+// when CompactGraph::integerWeightScale() is non-zero: a bucket queue when the
+// scaled maximum edge weight is small, a radix heap otherwise. Throws
+// std::runtime_error if an integer queue is requested for a graph whose
+// weights cannot be scaled to integers.
+QueuePolicy resolveQueuePolicy(QueuePolicy requested, const CompactGraph& graph);
+
+// Monotone radix heap over non-negative integral keys
+//
+// Drop-in for std::priority_queue<std::pair<double, int>, ..., greater>: keys
+// are stored as doubles but must hold integral values, and a pushed key must
+// not be smaller than the last key popped (smaller keys are clamped to it).
+// top() is non-const because it may redistribute a bucket.
+class RadixHeap {
+public:
+    using value_type = std::pair<double, int>;
+
+    void push(const value_type& value);
+    const value_type& top();
+    void pop();
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    void clear();
+
+private:
+    std::array<std::vector<value_type>, 65> buckets;
+    uint64_t last = 0;
+    size_t count = 0;
+
+    static size_t bucketIndex(uint64_t key, uint64_t last);
+    void refill();
+};
+
+// Dial bucket queue over non-negative integral keys
+//
+// One bucket per key value in a circular array that grows to cover the span
+// of queued keys, so push and pop are O(1) amortised when edge weights are
+// small integers. Same interface and monotonicity rule as RadixHeap.
+class BucketQueue {
+public:
+    using value_type = std::pair<double, int>;
+
+    explicit BucketQueue(size_t keySpan = 64);
+
+    void push(const value_type& value);
+    const value_type& top();
+    void pop();
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    void clear();
+
+    // Make room for keys up to keySpan above the current minimum
+    void reserveSpan(size_t keySpan);
+
+private:
+    std::vector<std::vector<value_type>> buckets;  // size is a power of two
+    uint64_t cursor = 0;
+    size_t count = 0;
+
+    void advance();
+};
+
+} // namespace sf
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace sf {
+
+// Component index used to reject unreachable queries without searching
+//
+// Nodes are dense slots 0..size()-1. Weakly connected components are kept in
+// a union-find (union by size, path halving) that is updated by every
+// addEdge, so they are always current. Strongly connected components come
+// from an iterative Tarjan pass in build(); each gets a rank in topological
+// order of the condensation, so every edge runs from a lower or equal rank to
+// a higher one. Later additions keep the ranks as long as an edge does not
+// point backwards in that order; the first one that does marks them stale
+// and queries fall back to the weak components until the next build().
+class ReachabilityIndex {
+public:
+    // Add an isolated node; returns its slot
+    int addNode();
+    void addEdge(int from, int to);
+
+    // Recompute everything from a CSR adjacency: the edges of slot i are
+    // targets[offsets[i] .. offsets[i + 1])
+    void build(const std::vector<size_t>& offsets, const std::vector<int>& targets);
+    void clear();
+
+    // False only if no path from -> to can exist
+    bool mayReach(int from, int to) const {
+        if (weakComponent(from) != weakComponent(to)) {
+            return false;
+        }
+        return !strongCurrent || ranks[from] <= ranks[to];
+    }
+
+    // Representative slot of the weak component
+    int weakComponent(int slot) const {
+        while (parents[slot] != slot) {
+            slot = parents[slot];
+        }
+        return slot;
+    }
+    // Topological rank of the strong component, -1 while stale
+    int strongComponent(int slot) const { return strongCurrent ? ranks[slot] : -1; }
+    bool strongIndexed() const { return strongCurrent; }
+
+    size_t size() const { return parents.size(); }
+
+private:
+    std::vector<int> parents;
+    std::vector<int> sizes;
+    std::vector<int> ranks;     // strong component rank per slot
+    int nextRank = 0;
+    bool strongCurrent = false;
+
+    int find(int slot);
+    void unite(int from, int to);
+};
+
+} // namespace sf
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "graph.h"
+#include "compact_graph.h"
+#include "search_workspace.h"
+#include "batch_planner.h"
+#include <chrono>
+#include <memory>
+
+namespace sf {
+
+// Point-to-point search that runs in slices
+//
+// Holds its open list, g values and parents between step() calls, so many
+// queries can share one thread by advancing each a little per frame. Supports
+// the single-direction algorithms (BFS, DFS, Dijkstra, BestFirst, AStar);
+// the bidirectional ones throw std::runtime_error. The graph must outlive the
+// search.
+//
+// Without a workspace the state lives in hash maps and costs memory in
+// proportion to the nodes touched. With a workspace the dense arrays are
+// faster, but the workspace belongs to this search until it is finished and
+// cannot be shared with other searches in progress.
+class ResumableSearch {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    ResumableSearch(const CompactGraph& graph, int startId, int goalId,
+                    PlanAlgorithm algorithm = PlanAlgorithm::AStar,
+                    Heuristic heuristic = heuristics::euclidean);
+    ResumableSearch(const CompactGraph& graph, int startId, int goalId,
+                    PlanAlgorithm algorithm, Heuristic heuristic, SearchWorkspace& workspace);
+    ~ResumableSearch();
+
+    ResumableSearch(ResumableSearch&&) noexcept;
+    ResumableSearch& operator=(ResumableSearch&&) noexcept;
+
+    // Expand up to maxExpansions nodes
+    SearchStatus step(size_t maxExpansions);
+    // Expand until budget has elapsed, checking the clock every 256 expansions
+    SearchStatus stepFor(Clock::duration budget);
+    // Run to completion
+    SearchStatus finish();
+
+    SearchStatus status() const;
+    size_t nodesExplored() const;
+    // The path once Found; otherwise found == false
+    PathResult result() const;
+
+    // Type-erased engine cursor, defined in the source file
+    struct State;
+
+private:
+    std::unique_ptr<State> state;
+};
+
+} // namespace sf
@@ -0,0 +1,483 @@
+#pragma once
+
+#include "graph.h"
+#include "compact_graph.h"
+#include "indexed_heap.h"
+#include "search_workspace.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sf {
+
+// Compile-time specialized best-first search
+//
+// BFS, DFS, Dijkstra, Best-First Search and A* (and weighted A*) differ only
+// in the open list, the priority of a node and whether a shorter path may
+// improve an already queued node. BestFirstEngine implements the loop once and
+// takes those choices as template parameters:
+//
+//   GraphView  - CompactGraphView (dense indices) or GraphView (hash-based Graph)
+//   Queue      - IndexedHeapQueue, LazyHeapQueue, IntegerQueue<Q>, FifoQueue, LifoQueue
+//   Visited    - DenseVisited (SearchWorkspace) or HashVisited
+//   H          - heuristic functor called as h(node, goalNode)
+//   Order      - CostOrder (key g + h, relax on shorter g) or GreedyOrder (key h)
+//
+// Everything is resolved at compile time, so heuristic calls inline and the
+// goal node is fetched once per search.
+namespace engine {
+
+// ---------------------------------------------------------------------------
+// Graph views. Nodes are addressed by an int handle: the dense index for a
+// CompactGraph, the node id itself for a Graph.
+
+class CompactGraphView {
+public:
+    explicit CompactGraphView(const CompactGraph& graph) : graph(graph) {}
+
+    size_t nodeCount() const { return graph.nodeCount(); }
+    bool contains(int id) const { return graph.hasNode(id); }
+    int handle(int id) const { return graph.indexOf(id); }
+    int id(int node) const { return graph.idOf(node); }
+    bool mayReach(int from, int to) const { return graph.mayReach(from, to); }
+    Node node(int node) const { return graph.node(node); }
+
+    template <typename F>
+    void forEachEdge(int node, F&& f) const {
+        for (size_t e = graph.edgeBegin(node); e < graph.edgeEnd(node); e++) {
+            f(graph.edgeTarget(e), graph.edgeWeight(e));
+        }
+    }
+
+    // Weight of the first from -> to edge
+    double edgeCost(int from, int to) const {
+        for (size_t e = graph.edgeBegin(from); e < graph.edgeEnd(from); e++) {
+            if (graph.edgeTarget(e) == to) {
+                return graph.edgeWeight(e);
+            }
+        }
+        return 0.0;
+    }
+
+private:
+    const CompactGraph& graph;
+};
+
+class GraphView {
+public:
+    explicit GraphView(const Graph& graph) : graph(graph) {}
+
+    size_t nodeCount() const { return graph.nodeCount(); }
+    bool contains(int id) const { return graph.hasNode(id); }
+    int handle(int id) const { return id; }
+    int id(int node) const { return node; }
+    bool mayReach(int from, int to) const { return graph.mayReach(from, to); }
+    const Node& node(int node) const { return graph.getNode(node); }
+
+    // Edges into blocked nodes are not traversable
+    template <typename F>
+    void forEachEdge(int node, F&& f) const {
+        for (const auto& edge : graph.getNeighbors(node)) {
+            if (!graph.isBlocked(edge.to)) {
+                f(edge.to, edge.weight);
+            }
+        }
+    }
+
+    double edgeCost(int from, int to) const {
+        for (const auto& edge : graph.getNeighbors(from)) {
+            if (edge.to == to) {
+                return edge.weight;
+            }
+        }
+        return 0.0;
+    }
+
+private:
+    const Graph& graph;
+};
+
+// ---------------------------------------------------------------------------
+// Visited policies: tentative distance, parent and closed flag per handle
+
+class DenseVisited {
+public:
+    explicit DenseVisited(SearchWorkspace& workspace) : workspace(workspace) {}
+
+    void prepare(size_t nodeCount) { workspace.prepare(nodeCount); }
+    double distance(int node) const { return workspace.distance(node); }
+    int parent(int node) const { return workspace.parent(node); }
+    void set(int node, double dist, int parent) { workspace.set(node, dist, parent); }
+    bool closed(int node) const { return workspace.closed(node); }
+    void close(int node) { workspace.close(node); }
+
+private:
+    SearchWorkspace& workspace;
+};
+
+// Only touched nodes are stored; the others are at infinite distance
+class HashVisited {
+public:
+    void prepare(size_t) { entries.clear(); }
+
+    double distance(int node) const {
+        auto it = entries.find(node);
+        return it == entries.end() ? std::numeric_limits<double>::infinity() : it->second.dist;
+    }
+    int parent(int node) const {
+        auto it = entries.find(node);
+        return it == entries.end() ? -1 : it->second.parent;
+    }
+    void set(int node, double dist, int parent) {
+        Entry& e = entries[node];
+        e.dist = dist;
+        e.parent = parent;
+    }
+    bool closed(int node) const {
+        auto it = entries.find(node);
+        return it != entries.end() && it->second.closed;
+    }
+    void close(int node) { entries[node].closed = true; }
+
+private:
+    struct Entry {
+        double dist = std::numeric_limits<double>::infinity();
+        int parent = -1;
+        bool closed = false;
+    };
+    std::unordered_map<int, Entry> entries;
+};
+
+// ---------------------------------------------------------------------------
+// Open lists. push(node, g, h) queues node with cost-so-far g and heuristic h.
+//   lazy          - pop() may return nodes that were already closed
+//   closesOnPush  - nodes are closed when discovered (BFS / DFS)
+
+// Indexed 4-ary heap with decrease-key, keyed by g + h
+class IndexedHeapQueue {
+public:
+    static constexpr bool lazy = false;
+    static constexpr bool closesOnPush = false;
+
+    explicit IndexedHeapQueue(IndexedDaryHeap<4>& heap) : heap(heap) {}
+
+    bool empty() const { return heap.empty(); }
+    bool contains(int node) const { return heap.contains(node); }
+    void push(int node, double g, double h) { heap.pushOrDecrease(node, g + h); }
+    int pop() { return heap.pop(); }
+
+private:
+    IndexedDaryHeap<4>& heap;
+};
+
+// Binary heap with lazy deletion; suits handles that are not dense indices
+class LazyHeapQueue {
+public:
+    static constexpr bool lazy = true;
+    static constexpr bool closesOnPush = false;
+
+    bool empty() const { return heap.empty(); }
+    bool contains(int) const { return false; }
+    void push(int node, double g, double h) { heap.push({g + h, node}); }
+    int pop() {
+        int node = heap.top().second;
+        heap.pop();
+        return node;
+    }
+
+private:
+    using Item = std::pair<double, int>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> heap;
+};
+
+// RadixHeap / BucketQueue adapter. Keys are g * scale + floor(h * scale): g is
+// integral after scaling and flooring keeps a consistent heuristic consistent.
+// Nodes with h = inf cannot reach the goal and are not queued.
+template <typename Q>
+class IntegerQueue {
+public:
+    static constexpr bool lazy = true;
+    static constexpr bool closesOnPush = false;
+
+    IntegerQueue(Q& queue, double scale) : queue(queue), scale(scale) {}
+
+    bool empty() const { return queue.empty(); }
+    bool contains(int) const { return false; }
+    void push(int node, double g, double h) {
+        double key = g * scale + std::floor(h * scale);
+        if (!std::isinf(key)) {
+            queue.push({key, node});
+        }
+    }
+    int pop() {
+        int node = queue.top().second;
+        queue.pop();
+        return node;
+    }
+
+private:
+    Q& queue;
+    double scale;
+};
+
+// FIFO over a (key, node) list; entries before head have been dequeued
+class FifoQueue {
+public:
+    static constexpr bool lazy = false;
+    static constexpr bool closesOnPush = true;
+
+    explicit FifoQueue(std::vector<std::pair<double, int>>& items) : items(items) {
+        items.clear();
+    }
+
+    bool empty() const { return head == items.size(); }
+    bool contains(int) const { return false; }
+    void push(int node, double g, double) { items.emplace_back(g, node); }
+    int pop() { return items[head++].second; }
+
+private:
+    std::vector<std::pair<double, int>>& items;
+    size_t head = 0;
+};
+
+class LifoQueue {
+public:
+    static constexpr bool lazy = false;
+    static constexpr bool closesOnPush = true;
+
+    explicit LifoQueue(std::vector<std::pair<double, int>>& items) : items(items) {
+        items.clear();
+    }
+
+    bool empty() const { return items.empty(); }
+    bool contains(int) const { return false; }
+    void push(int node, double g, double) { items.emplace_back(g, node); }
+    int pop() {
+        int node = items.back().second;
+        items.pop_back();
+        return node;
+    }
+
+private:
+    std::vector<std::pair<double, int>>& items;
+};
+
+// ---------------------------------------------------------------------------
+// Heuristic functors
+
+struct ZeroHeuristic {
+    double operator()(const Node&, const Node&) const { return 0.0; }
+};
+
+struct EuclideanHeuristic {
+    double operator()(const Node& a, const Node& b) const { return a.distance(b); }
+};
+
+struct ManhattanHeuristic {
+    double operator()(const Node& a, const Node& b) const {
+        return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+    }
+};
+
+// Type-erased fallback for arbitrary sf::Heuristic values
+struct FunctionHeuristic {
+    const Heuristic& heuristic;
+    double operator()(const Node& a, const Node& b) const { return heuristic(a, b); }
+};
+
+// w * h: weighted A* returns paths within a factor w of optimal
+template <typename H>
+struct WeightedHeuristic {
+    H base;
+    double weight;
+    double operator()(const Node& a, const Node& b) const { return weight * base(a, b); }
+};
+
+// Calls f with the cheapest functor equivalent to heuristic: the built-in
+// heuristics are recognised through std::function::target and inlined.
+template <typename F>
+decltype(auto) withHeuristic(const Heuristic& heuristic, F&& f) {
+    using Function = double (*)(const Node&, const Node&);
+    if (const Function* fn = heuristic.target<Function>()) {
+        if (*fn == &heuristics::euclidean) {
+            return f(EuclideanHeuristic{});
+        }
+        if (*fn == &heuristics::manhattan) {
+            return f(ManhattanHeuristic{});
+        }
+        if (*fn == &heuristics::zero) {
+            return f(ZeroHeuristic{});
+        }
+    }
+    return f(FunctionHeuristic{heuristic});
+}
+
+// ---------------------------------------------------------------------------
+// Orders
+
+// Dijkstra / A*: key g + h, a shorter g re-keys an open node, the path cost is g(goal)
+struct CostOrder {
+    static constexpr bool relax = true;
+};
+
+// Greedy best-first: key h only, every node is queued once
+struct GreedyOrder {
+    static constexpr bool relax = false;
+};
+
+// ---------------------------------------------------------------------------
+
+template <typename GraphViewT, typename Queue, typename Visited, typename H,
+          typename Order = CostOrder>
+class BestFirstEngine {
+public:
+    // One search in progress. The graph view, queue, visited policy and
+    // heuristic are held by reference and must outlive the cursor; between
+    // advance() calls they carry the whole search state.
+    class Cursor {
+    public:
+        Cursor(const GraphViewT& graph, Queue& queue, Visited& visited, const H& heuristic,
+               int startId, int goalId)
+            : graph(graph), queue(queue), visited(visited), heuristic(heuristic) {
+            if (!graph.contains(startId) || !graph.contains(goalId)) {
+                state = SearchStatus::Failed;
+                return;
+            }
+            const int start = graph.handle(startId);
+            goal = graph.handle(goalId);
+            if (!graph.mayReach(start, goal)) {
+                // Different components: fail before touching the visited storage
+                state = SearchStatus::Failed;
+                return;
+            }
+            goalNode = graph.node(goal);
+
+            visited.prepare(graph.nodeCount());
+            visited.set(start, 0.0, -1);
+            if constexpr (Queue::closesOnPush) {
+                visited.close(start);
+            }
+            queue.push(start, 0.0, heuristic(graph.node(start), goalNode));
+        }
+
+        // Expand up to maxExpansions nodes; Running means the budget ran out
+        SearchStatus advance(size_t maxExpansions) {
+            if (state != SearchStatus::Running) {
+                return state;
+            }
+            const int goal = this->goal;
+            const Node goalNode = this->goalNode;
+            size_t budget = maxExpansions;
+
+            while (!queue.empty()) {
+                if (budget == 0) {
+                    return state;
+                }
+                int current = queue.pop();
+                if constexpr (!Queue::closesOnPush) {
+                    if (Queue::lazy && visited.closed(current)) {
+                        continue;
+                    }
+                    visited.close(current);
+                }
+                nodesExplored++;
+                budget--;
+
+                if (current == goal) {
+                    return state = SearchStatus::Found;
+                }
+
+                const double g = visited.distance(current);
+                graph.forEachEdge(current, [&](int next, double weight) {
+                    if (visited.closed(next)) {
+                        return;
+                    }
+                    if constexpr (Queue::closesOnPush) {
+                        // Discovery order: g counts hops
+                        visited.close(next);
+                        visited.set(next, g + 1.0, current);
+                        queue.push(next, g + 1.0, 0.0);
+                    } else if constexpr (Order::relax) {
+                        double tentative = g + weight;
+                        if (tentative < visited.distance(next)) {
+                            visited.set(next, tentative, current);
+                            queue.push(next, tentative, heuristic(graph.node(next), goalNode));
+                        }
+                    } else {
+                        // Greedy priority depends only on the node, so evaluate h once per node
+                        visited.set(next, 0.0, current);
+                        if (!queue.contains(next)) {
+                            queue.push(next, 0.0, heuristic(graph.node(next), goalNode));
+                        }
+                    }
+                });
+            }
+            return state = SearchStatus::Failed;
+        }
+
+        SearchStatus status() const { return state; }
+        size_t expanded() const { return nodesExplored; }
+
+        // The path once advance() returned Found, otherwise an empty result
+        PathResult result() const {
+            if (state != SearchStatus::Found) {
+                PathResult none;
+                none.nodesExplored = nodesExplored;
+                return none;
+            }
+            std::vector<int> path;
+            for (int node = goal; node != -1; node = visited.parent(node)) {
+                path.push_back(graph.id(node));
+            }
+            std::reverse(path.begin(), path.end());
+
+            // Only cost-ordered searches keep path costs in the visited entries
+            double cost = 0.0;
+            if constexpr (Order::relax && !Queue::closesOnPush) {
+                cost = visited.distance(goal);
+            } else {
+                for (int node = goal; visited.parent(node) != -1; node = visited.parent(node)) {
+                    cost += graph.edgeCost(visited.parent(node), node);
+                }
+            }
+            return PathResult(path, cost, nodesExplored);
+        }
+
+    private:
+        const GraphViewT& graph;
+        Queue& queue;
+        Visited& visited;
+        const H& heuristic;
+        int goal = -1;
+        Node goalNode;
+        size_t nodesExplored = 0;
+        SearchStatus state = SearchStatus::Running;
+    };
+
+    static PathResult search(const GraphViewT& graph, Queue& queue, Visited& visited,
+                             const H& heuristic, int startId, int goalId) {
+        Cursor cursor(graph, queue, visited, heuristic, startId, goalId);
+        if (cursor.advance(std::numeric_limits<size_t>::max()) != SearchStatus::Found) {
+            return PathResult();
+        }
+        return cursor.result();
+    }
+};
+
+// Deduces the engine instantiation from its arguments
+template <typename Order = CostOrder, typename GraphViewT, typename Queue, typename Visited,
+          typename H>
+PathResult run(const GraphViewT& graph, Queue& queue, Visited& visited, const H& heuristic,
+               int startId, int goalId) {
+    return BestFirstEngine<GraphViewT, Queue, Visited, H, Order>::search(
+        graph, queue, visited, heuristic, startId, goalId);
+}
+
+} // namespace engine
+
+} // namespace sf
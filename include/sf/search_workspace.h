@@ -0,0 +1,81 @@
+#pragma once
+
+#include "indexed_heap.h"
+#include "priority_queues.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace sf {
+
+// Reusable scratch memory for searches over a CompactGraph
+//
+// Holds dense distance / parent / closed arrays indexed by CompactGraph node
+// index plus the open-list storage. Entries are invalidated in O(1) by bumping
+// a generation counter, so a query only pays for the nodes it touches and a
+// warmed-up workspace performs no heap allocation. A workspace is not
+// thread-safe; use one per thread (see local()).
+class SearchWorkspace {
+private:
+    struct Entry {
+        double dist;
+        int parent;
+        uint32_t stamp;        // generation in which dist/parent were written
+        uint32_t closedStamp;  // generation in which the node was closed
+    };
+
+    std::vector<Entry> entries;
+    std::vector<std::pair<double, int>> openList;
+    IndexedDaryHeap<4> openHeap;
+    RadixHeap radix;
+    BucketQueue buckets;
+    uint32_t generation = 0;
+
+public:
+    // Invalidate all entries and make room for nodeCount nodes
+    void prepare(size_t nodeCount);
+
+    double distance(int node) const {
+        const Entry& e = entries[node];
+        return e.stamp == generation ? e.dist : std::numeric_limits<double>::infinity();
+    }
+    int parent(int node) const {
+        const Entry& e = entries[node];
+        return e.stamp == generation ? e.parent : -1;
+    }
+    void set(int node, double dist, int parent) {
+        Entry& e = entries[node];
+        e.stamp = generation;
+        e.dist = dist;
+        e.parent = parent;
+    }
+
+    bool closed(int node) const { return entries[node].closedStamp == generation; }
+    void close(int node) { entries[node].closedStamp = generation; }
+    void reopen(int node) { entries[node].closedStamp = 0; }
+
+    // Open-list storage used as a FIFO or stack by BFS / DFS
+    std::vector<std::pair<double, int>>& list() { return openList; }
+
+    // Indexed priority queue (with decrease-key) for the best-first searches
+    IndexedDaryHeap<4>& indexedHeap() { return openHeap; }
+
+    // Integer-key queues for QueuePolicy::RadixHeap / BucketQueue
+    RadixHeap& radixHeap() { return radix; }
+    BucketQueue& bucketQueue() { return buckets; }
+
+    size_t capacity() const { return entries.size(); }
+    // Bytes held by the node entries, the list and the indexed heap
+    size_t memoryUsage() const {
+        return entries.capacity() * sizeof(Entry) +
+               openList.capacity() * sizeof(std::pair<double, int>) + openHeap.memoryUsage();
+    }
+
+    // Workspaces owned by the calling thread; slot 1 is used by the backward
+    // half of the bidirectional searches
+    static SearchWorkspace& local(size_t slot = 0);
+};
+
+} // namespace sf
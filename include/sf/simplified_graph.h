@@ -0,0 +1,90 @@
+#pragma once
+
+#include "graph.h"
+#include "compact_graph.h"
+#include "search_workspace.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace sf {
+
+// Graph with its degree-2 chains collapsed into single edges
+//
+// A node is a chain node when it has exactly two distinct neighbours (over
+// incoming and outgoing edges) and no self-loop. Every maximal run of chain
+// nodes between two kept nodes a and b becomes one a -> b edge weighted with
+// the sum of the chain's cheapest forward hops, and likewise b -> a, where
+// every hop has an edge in that direction. A shortcut is only added when it
+// is cheaper than every existing edge between its ends. A ring made only of
+// chain nodes keeps one of them.
+//
+// The reduced graph has the kept nodes with their original ids and
+// coordinates, so any planner can run on graph() / compact() and the result
+// be turned back into original node sequences with expand(). search() runs
+// A* on the reduced graph directly and also accepts contracted start and
+// goal nodes, which it attaches to the ends of their chains.
+class SimplifiedGraph {
+public:
+    explicit SimplifiedGraph(const Graph& graph);
+
+    // Reduced graph: kept nodes, their direct edges and the chain shortcuts
+    const Graph& graph() const { return reduced; }
+    const CompactGraph& compact() const { return frozen; }
+
+    size_t originalNodeCount() const { return reduced.nodeCount() + positions.size(); }
+    size_t contractedNodeCount() const { return positions.size(); }
+    size_t chainCount() const { return chains.size(); }
+    bool contracted(int id) const { return positions.count(id) > 0; }
+
+    // Original node sequence of a path over the reduced graph
+    std::vector<int> expandPath(const std::vector<int>& path) const;
+    // Same result with its path expanded; cost and nodesExplored are kept
+    PathResult expand(const PathResult& result) const;
+
+    // Shortest path between original nodes, returned in original ids;
+    // nodesExplored counts reduced-graph expansions
+    PathResult search(int startId, int goalId,
+                      Heuristic heuristic = heuristics::euclidean) const;
+    PathResult search(int startId, int goalId, Heuristic heuristic,
+                      SearchWorkspace& workspace) const;
+
+private:
+    // nodes[0] and nodes.back() are the kept ends (equal for a loop);
+    // forward[i] / backward[i] are the cheapest nodes[i] -> nodes[i + 1] and
+    // nodes[i + 1] -> nodes[i] weights, infinity if there is no such edge
+    struct Chain {
+        std::vector<int> nodes;
+        std::vector<double> forward;
+        std::vector<double> backward;
+
+        // Cost of walking the chain from index from to index to
+        double cost(size_t from, size_t to) const;
+        // Node ids strictly between from and to, in walking order
+        void appendBetween(size_t from, size_t to, std::vector<int>& out) const;
+    };
+
+    struct Position {
+        int chain;
+        size_t index;
+        Node node;
+    };
+
+    struct Shortcut {
+        int chain;
+        bool forward;
+    };
+
+    Graph reduced;
+    CompactGraph frozen;
+    std::vector<Chain> chains;
+    std::unordered_map<int, Position> positions;        // contracted id -> place in its chain
+    std::unordered_map<uint64_t, Shortcut> shortcuts;   // (from, to) of each shortcut edge
+
+    static uint64_t pairKey(int from, int to) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(from)) << 32) |
+               static_cast<uint32_t>(to);
+    }
+};
+
+} // namespace sf
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sf {
+
+// Fixed-size pool of worker threads for data-parallel loops
+//
+// The calling thread takes part in every loop as worker 0, so a pool of size
+// one runs everything inline. Worker indices are stable and lie in
+// [0, size()), which lets callers keep per-worker scratch buffers.
+//
+// parallelFor splits the index range into one contiguous block per worker.
+// Workers take grain-sized chunks from the front of their own block and, once
+// it is empty, steal the back half of another worker's block, so uneven task
+// costs are balanced while each worker mostly walks consecutive indices.
+class ThreadPool {
+public:
+    // threads == 0 selects std::thread::hardware_concurrency()
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers.size() + 1; }
+
+    // Call fn(index, worker) for every index in [0, count), in chunks of
+    // grain; blocks until all calls returned and rethrows the first exception
+    // thrown by fn.
+    void parallelFor(size_t count, const std::function<void(size_t, size_t)>& fn,
+                     size_t grain = 1);
+
+    static size_t defaultThreadCount();
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    // Remaining indices [begin, end) of one worker's block
+    struct alignas(64) Block {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    // Current loop, guarded by mutex except for the per-worker blocks
+    const std::function<void(size_t, size_t)>* job = nullptr;
+    size_t jobGrain = 1;
+    std::unique_ptr<Block[]> blocks;
+    size_t generation = 0;
+    size_t busy = 0;
+    bool stopping = false;
+    std::exception_ptr error;
+
+    void workerLoop(size_t worker);
+    void runChunks(size_t worker);
+    bool takeChunk(size_t worker, size_t& begin, size_t& end);
+    bool steal(size_t worker);
+    void cancel();
+};
+
+} // namespace sf
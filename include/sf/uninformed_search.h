@@ -1,6 +1,9 @@
 #pragma once
 
 #include "graph.h"
+#include "compact_graph.h"
+#include "search_workspace.h"
+#include "priority_queues.h"
 #include <queue>
 #include <stack>
 
@@ -10,18 +13,40 @@ namespace sf {
 class BFS {
 public:
     static PathResult search(const Graph& graph, int startId, int goalId);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId,
+                            SearchWorkspace& workspace);
 };
 
 // 1.2 Depth-First Search (DFS)
 class DFS {
 public:
     static PathResult search(const Graph& graph, int startId, int goalId);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId,
+                            SearchWorkspace& workspace);
 };
 
 // 1.3 Dijkstra's Algorithm
 class Dijkstra {
 public:
     static PathResult search(const Graph& graph, int startId, int goalId);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId,
+                            SearchWorkspace& workspace,
+                            QueuePolicy queue = QueuePolicy::Auto);
+};
+
+// 1.4 Bidirectional Dijkstra
+// Searches forward from the start and backward (over incoming edges) from the
+// goal, stopping once the two frontiers prove the best meeting point optimal.
+class BidirectionalDijkstra {
+public:
+    // Freezes the graph for this call; freeze once and reuse for many queries
+    static PathResult search(const Graph& graph, int startId, int goalId);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId);
+    static PathResult search(const CompactGraph& graph, int startId, int goalId,
+                            SearchWorkspace& forward, SearchWorkspace& backward);
 };
 
 } // namespace sf
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "graph.h"
+#include "reachability.h"
+#include "search_workspace.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace sf {
+
+// Immutable version of a VersionedGraph, pinned by the reader that holds it
+//
+// Copying a snapshot copies one shared_ptr. Nodes are addressed by dense
+// index (ascending id order, as in CompactGraph); the outgoing edges of a
+// node live in the CSR chunk that covers its index.
+class GraphSnapshot {
+public:
+    // Nodes per edge chunk
+    static constexpr int kChunkBits = 8;
+    static constexpr int kChunkNodes = 1 << kChunkBits;
+
+    GraphSnapshot() = default;
+
+    bool empty() const { return state == nullptr; }
+    uint64_t version() const { return state->number; }
+    size_t nodeCount() const { return state->nodes->ids.size(); }
+    size_t edgeCount() const { return state->edges; }
+
+    bool hasNode(int id) const { return indexOf(id) >= 0; }
+    // Dense index of an original node id, or -1 if the node does not exist
+    int indexOf(int id) const;
+    int idOf(int index) const { return state->nodes->ids[index]; }
+    Node node(int index) const;
+
+    // False only if no path between the dense indices can exist
+    bool mayReach(int from, int to) const { return state->reach->mayReach(from, to); }
+
+    // f(target index, weight) for every outgoing edge of a dense index
+    template <typename F>
+    void forEachEdge(int index, F&& f) const {
+        const Chunk& chunk = *state->chunks[index >> kChunkBits];
+        const int local = index & (kChunkNodes - 1);
+        for (uint32_t e = chunk.offsets[local]; e < chunk.offsets[local + 1]; e++) {
+            f(chunk.targets[e], chunk.weights[e]);
+        }
+    }
+
+    // Cheapest from -> to weight by node id, infinity if there is no such edge
+    double edgeWeight(int fromId, int toId) const;
+
+    // Edge chunks this snapshot has in common with other (same memory)
+    size_t sharedChunks(const GraphSnapshot& other) const;
+
+    // A* over this version only, whatever the writer publishes meanwhile
+    PathResult search(int startId, int goalId,
+                      Heuristic heuristic = heuristics::euclidean) const;
+    PathResult search(int startId, int goalId, Heuristic heuristic,
+                      SearchWorkspace& workspace) const;
+
+private:
+    friend class VersionedGraph;
+
+    // Shared by every version: the node set never changes
+    struct NodeTable {
+        std::vector<int> ids;                // dense index -> original id
+        std::unordered_map<int, int> index;  // original id -> dense index
+        std::vector<double> xs;
+        std::vector<double> ys;
+    };
+
+    // CSR block of kChunkNodes consecutive dense indices (fewer in the last)
+    struct Chunk {
+        std::vector<uint32_t> offsets;       // local node count + 1 entries
+        std::vector<int> targets;            // dense target index per edge
+        std::vector<double> weights;
+    };
+
+    struct Version {
+        uint64_t number = 0;
+        size_t edges = 0;
+        std::shared_ptr<const NodeTable> nodes;
+        std::shared_ptr<const ReachabilityIndex> reach;
+        std::vector<std::shared_ptr<const Chunk>> chunks;
+    };
+
+    explicit GraphSnapshot(std::shared_ptr<const Version> state) : state(std::move(state)) {}
+
+    std::shared_ptr<const Version> state;
+};
+
+// Copy-on-write graph for many concurrent readers and one writer
+//
+// Readers call snapshot() and query the returned version for as long as
+// they hold it; it never changes underneath them. The writer edits edges
+// (the node set is fixed at construction) and calls publish(): each chunk
+// touched since the last publish is copied once, and the new version shares
+// every other chunk with the previous one. publish() swaps the current
+// version with an atomic shared_ptr store, and a version is freed when the
+// last snapshot holding it goes away.
+//
+// snapshot() and version() are thread-safe. The edit methods and publish()
+// must be called from one writer thread at a time.
+class VersionedGraph {
+public:
+    explicit VersionedGraph(const Graph& graph);
+
+    VersionedGraph(const VersionedGraph&) = delete;
+    VersionedGraph& operator=(const VersionedGraph&) = delete;
+
+    // Pin the latest published version
+    GraphSnapshot snapshot() const;
+    uint64_t version() const { return snapshot().version(); }
+
+    // Staged until publish(); unknown ids throw, as do the first two when
+    // there is no from -> to edge
+    void setEdgeWeight(int fromId, int toId, double weight);  // every from -> to edge
+    void removeEdge(int fromId, int toId);                    // every from -> to edge
+    void addEdge(int fromId, int toId, double weight);
+
+    // Make the staged edits visible as a new version and return its number;
+    // without staged edits the current version is kept
+    uint64_t publish();
+    // Chunks copied since the last publish
+    size_t stagedChunks() const { return staged.size(); }
+
+private:
+    // Replaced with atomic_store; readers take it with atomic_load
+    std::shared_ptr<const GraphSnapshot::Version> current;
+    std::unordered_map<int, std::shared_ptr<GraphSnapshot::Chunk>> staged;
+    long long stagedEdges = 0;
+    // Copy of the index, made once an added edge joins nodes it kept apart
+    std::shared_ptr<ReachabilityIndex> stagedReach;
+
+    int indexOf(int id) const;
+    // Writable copy of the chunk covering a dense index
+    GraphSnapshot::Chunk& stage(int index);
+};
+
+} // namespace sf
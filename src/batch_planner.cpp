@@ -0,0 +1,72 @@
+#include "sf/batch_planner.h"
+#include "sf/uninformed_search.h"
+#include "sf/informed_search.h"
+#include <chrono>
+
+namespace sf {
+
+BatchPlanner::BatchPlanner(const CompactGraph& graph, size_t threads, Heuristic heuristic)
+    : compact(&graph), heuristic(heuristic), pool(threads), scratch(pool.size()) {}
+
+BatchPlanner::BatchPlanner(const Graph& graph, size_t threads, Heuristic heuristic)
+    : owned(new CompactGraph(graph)), compact(owned.get()), heuristic(heuristic),
+      pool(threads), scratch(pool.size()) {}
+
+PathResult BatchPlanner::solve(const PlanRequest& request, Scratch& local) const {
+    const CompactGraph& graph = *compact;
+    switch (request.algorithm) {
+    case PlanAlgorithm::BFS:
+        return BFS::search(graph, request.startId, request.goalId, local.forward);
+    case PlanAlgorithm::DFS:
+        return DFS::search(graph, request.startId, request.goalId, local.forward);
+    case PlanAlgorithm::Dijkstra:
+        return Dijkstra::search(graph, request.startId, request.goalId, local.forward);
+    case PlanAlgorithm::BestFirst:
+        return BestFirstSearch::search(graph, request.startId, request.goalId, heuristic,
+                                       local.forward);
+    case PlanAlgorithm::AStar:
+        return AStar::search(graph, request.startId, request.goalId, heuristic, local.forward);
+    case PlanAlgorithm::BidirectionalDijkstra:
+        return BidirectionalDijkstra::search(graph, request.startId, request.goalId,
+                                             local.forward, local.backward);
+    case PlanAlgorithm::BidirectionalAStar:
+        return BidirectionalAStar::search(graph, request.startId, request.goalId, heuristic,
+                                          local.forward, local.backward);
+    }
+    return PathResult();
+}
+
+BatchStats BatchPlanner::run(const PlanRequest* requests, size_t count, PathResult* results) {
+    for (auto& local : scratch) {
+        local.found = 0;
+        local.nodesExplored = 0;
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    pool.parallelFor(count, [&](size_t i, size_t worker) {
+        Scratch& local = scratch[worker];
+        results[i] = solve(requests[i], local);
+        local.found += results[i].found ? 1 : 0;
+        local.nodesExplored += results[i].nodesExplored;
+    }, 4);
+    auto end = std::chrono::steady_clock::now();
+
+    BatchStats stats;
+    stats.queries = count;
+    stats.threads = pool.size();
+    for (const auto& local : scratch) {
+        stats.found += local.found;
+        stats.nodesExplored += local.nodesExplored;
+    }
+    stats.seconds = std::chrono::duration<double>(end - begin).count();
+    stats.queriesPerSecond = stats.seconds > 0.0 ? count / stats.seconds : 0.0;
+    return stats;
+}
+
+BatchStats BatchPlanner::run(const std::vector<PlanRequest>& requests,
+                             std::vector<PathResult>& results) {
+    results.resize(requests.size());
+    return run(requests.data(), requests.size(), results.data());
+}
+
+} // namespace sf
@@ -0,0 +1,118 @@
+#pragma once
+
+// Internal bidirectional search shared by BidirectionalDijkstra and
+// BidirectionalAStar
+
+#include "sf/compact_graph.h"
+#include "sf/search_workspace.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace sf {
+
+namespace bidirectional_internal {
+
+// Runs a forward search from start over outgoing edges and a backward search
+// from goal over incoming edges, each on its own workspace. potential(v) is the
+// forward potential pf: forward keys are df(v) + pf(v), backward keys are
+// db(v) - pf(v). With pf = 0 this is bidirectional Dijkstra; with the average
+// potential (h(v, goal) - h(start, v)) / 2 it is bidirectional A*. Both
+// directions then see the same non-negative reduced costs, so the search may
+// stop once topForward + topBackward >= the best meeting cost mu.
+template <typename Potential>
+PathResult search(const CompactGraph& graph, int start, int goal,
+                  SearchWorkspace& forward, SearchWorkspace& backward,
+                  Potential potential) {
+    if (start == goal) {
+        return PathResult(std::vector<int>{graph.idOf(start)}, 0.0, 1);
+    }
+
+    forward.prepare(graph.nodeCount());
+    backward.prepare(graph.nodeCount());
+    auto& forwardHeap = forward.indexedHeap();
+    auto& backwardHeap = backward.indexedHeap();
+
+    // Backward parent links point towards the goal
+    forward.set(start, 0.0, -1);
+    forwardHeap.push(start, potential(start));
+    backward.set(goal, 0.0, -1);
+    backwardHeap.push(goal, -potential(goal));
+
+    double mu = std::numeric_limits<double>::infinity();
+    int meetFrom = -1;  // best path: start .. meetFrom -> meetTo .. goal
+    int meetTo = -1;
+    size_t nodesExplored = 0;
+
+    while (!forwardHeap.empty() && !backwardHeap.empty()) {
+        if (forwardHeap.topKey() + backwardHeap.topKey() >= mu) {
+            break;
+        }
+
+        if (forwardHeap.topKey() <= backwardHeap.topKey()) {
+            int u = forwardHeap.pop();
+            forward.close(u);
+            nodesExplored++;
+
+            double du = forward.distance(u);
+            for (size_t e = graph.edgeBegin(u); e < graph.edgeEnd(u); e++) {
+                int v = graph.edgeTarget(e);
+                double dv = du + graph.edgeWeight(e);
+
+                double through = dv + backward.distance(v);
+                if (through < mu) {
+                    mu = through;
+                    meetFrom = u;
+                    meetTo = v;
+                }
+
+                if (!forward.closed(v) && dv < forward.distance(v)) {
+                    forward.set(v, dv, u);
+                    forwardHeap.pushOrDecrease(v, dv + potential(v));
+                }
+            }
+        } else {
+            int u = backwardHeap.pop();
+            backward.close(u);
+            nodesExplored++;
+
+            double du = backward.distance(u);
+            for (size_t e = graph.reverseBegin(u); e < graph.reverseEnd(u); e++) {
+                int v = graph.reverseSource(e);
+                double dv = du + graph.reverseWeight(e);
+
+                double through = dv + forward.distance(v);
+                if (through < mu) {
+                    mu = through;
+                    meetFrom = v;
+                    meetTo = u;
+                }
+
+                if (!backward.closed(v) && dv < backward.distance(v)) {
+                    backward.set(v, dv, u);
+                    backwardHeap.pushOrDecrease(v, dv - potential(v));
+                }
+            }
+        }
+    }
+
+    if (meetFrom < 0) {
+        return PathResult();
+    }
+
+    // Splice the forward half (reversed) with the backward half
+    std::vector<int> path;
+    for (int node = meetFrom; node != -1; node = forward.parent(node)) {
+        path.push_back(graph.idOf(node));
+    }
+    std::reverse(path.begin(), path.end());
+    for (int node = meetTo; node != -1; node = backward.parent(node)) {
+        path.push_back(graph.idOf(node));
+    }
+
+    return PathResult(path, mu, nodesExplored);
+}
+
+} // namespace bidirectional_internal
+
+} // namespace sf
@@ -0,0 +1,116 @@
+#include "sf/compact_graph.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace sf {
+
+namespace {
+
+// Largest scale we accept, and the largest scaled weight (keeps path sums exact)
+const double kMaxWeightScale = 65536.0;
+const double kMaxScaledWeight = 4294967296.0;
+
+std::atomic<uint64_t> lastVersion{0};
+
+} // namespace
+
+CompactGraph::CompactGraph(const Graph& graph) : snapshotVersion(++lastVersion) {
+    ids = graph.getNodeIds();
+    std::sort(ids.begin(), ids.end());
+
+    const size_t n = ids.size();
+    index.reserve(n);
+    xs.resize(n);
+    ys.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        const Node& node = graph.getNode(ids[i]);
+        index[ids[i]] = static_cast<int>(i);
+        xs[i] = node.x;
+        ys[i] = node.y;
+    }
+
+    // Edges into blocked nodes are left out, like the parked ones
+    offsets.resize(n + 1);
+    offsets[0] = 0;
+    for (size_t i = 0; i < n; i++) {
+        size_t count = 0;
+        for (const auto& edge : graph.getNeighbors(ids[i])) {
+            count += graph.isBlocked(edge.to) ? 0 : 1;
+        }
+        offsets[i + 1] = offsets[i] + count;
+    }
+
+    targets.resize(offsets[n]);
+    weights.resize(offsets[n]);
+    for (size_t i = 0; i < n; i++) {
+        size_t e = offsets[i];
+        for (const auto& edge : graph.getNeighbors(ids[i])) {
+            if (graph.isBlocked(edge.to)) {
+                continue;
+            }
+            targets[e] = index[edge.to];
+            weights[e] = edge.weight;
+            e++;
+        }
+    }
+    
+    // Reverse CSR: bucket every edge under its target
+    inOffsets.assign(n + 1, 0);
+    for (int t : targets) {
+        inOffsets[t + 1]++;
+    }
+    for (size_t i = 0; i < n; i++) {
+        inOffsets[i + 1] += inOffsets[i];
+    }
+    inSources.resize(targets.size());
+    inEdges.resize(targets.size());
+    std::vector<size_t> fill(inOffsets.begin(), inOffsets.end() - 1);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t e = offsets[i]; e < offsets[i + 1]; e++) {
+            size_t slot = fill[targets[e]]++;
+            inSources[slot] = static_cast<int>(i);
+            inEdges[slot] = e;
+        }
+    }
+    
+    reach.build(offsets, targets);
+    
+    // Find the power-of-two scale that turns every weight into an integer
+    weightScale = 1.0;
+    for (double w : weights) {
+        maxWeight = std::max(maxWeight, w);
+        if (weightScale == 0.0) {
+            continue;
+        }
+        if (!(w >= 0.0) || std::isinf(w)) {
+            weightScale = 0.0;
+            continue;
+        }
+        while (std::floor(w * weightScale) != w * weightScale) {
+            weightScale *= 2.0;
+            if (weightScale > kMaxWeightScale) {
+                weightScale = 0.0;
+                break;
+            }
+        }
+    }
+    if (weightScale != 0.0 && maxWeight * weightScale > kMaxScaledWeight) {
+        weightScale = 0.0;
+    }
+}
+
+bool CompactGraph::hasNode(int id) const {
+    return index.find(id) != index.end();
+}
+
+int CompactGraph::indexOf(int id) const {
+    auto it = index.find(id);
+    return it == index.end() ? -1 : it->second;
+}
+
+CompactGraph Graph::freeze() const {
+    return CompactGraph(*this);
+}
+
+} // namespace sf
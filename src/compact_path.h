@@ -0,0 +1,44 @@
+#pragma once
+
+// Internal helpers shared by the CompactGraph search overloads
+
+#include "sf/compact_graph.h"
+#include "sf/search_workspace.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace sf {
+
+namespace compact_internal {
+
+// Walk dense parent links back from goal and translate to original ids
+inline std::vector<int> reconstructPath(const CompactGraph& graph,
+                                        const SearchWorkspace& workspace, int goal) {
+    std::vector<int> path;
+    for (int node = goal; node != -1; node = workspace.parent(node)) {
+        path.push_back(graph.idOf(node));
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+// Sum of the cheapest edge between consecutive dense indices of the parent chain
+inline double pathCost(const CompactGraph& graph, const SearchWorkspace& workspace, int goal) {
+    double cost = 0.0;
+    for (int node = goal; workspace.parent(node) != -1; node = workspace.parent(node)) {
+        int from = workspace.parent(node);
+        double best = std::numeric_limits<double>::infinity();
+        for (size_t e = graph.edgeBegin(from); e < graph.edgeEnd(from); e++) {
+            if (graph.edgeTarget(e) == node) {
+                best = std::min(best, graph.edgeWeight(e));
+            }
+        }
+        cost += best;
+    }
+    return cost;
+}
+
+} // namespace compact_internal
+
+} // namespace sf
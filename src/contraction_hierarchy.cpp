@@ -0,0 +1,591 @@
+#include "sf/contraction_hierarchy.h"
+#include "sf/indexed_heap.h"
+#include "sf/thread_pool.h"
+#include <algorithm>
+#include <limits>
+
+namespace sf {
+
+namespace {
+
+struct WorkArc {
+    int node;
+    double weight;
+    int middle;
+};
+
+struct Shortcut {
+    int from;
+    int to;
+    double weight;
+};
+
+// Mutable overlay graph used while contracting
+class Contractor {
+public:
+    std::vector<std::vector<WorkArc>> out;
+    std::vector<std::vector<WorkArc>> in;
+    std::vector<char> contracted;
+    std::vector<int> contractedNeighbors;
+    size_t settleLimit;
+
+    Contractor(const CompactGraph& graph, size_t limit)
+        : out(graph.nodeCount()), in(graph.nodeCount()),
+          contracted(graph.nodeCount(), 0), contractedNeighbors(graph.nodeCount(), 0),
+          settleLimit(limit) {
+        for (size_t v = 0; v < graph.nodeCount(); v++) {
+            int from = static_cast<int>(v);
+            for (size_t e = graph.edgeBegin(from); e < graph.edgeEnd(from); e++) {
+                addArc(from, graph.edgeTarget(e), graph.edgeWeight(e), -1);
+            }
+        }
+    }
+
+    // Insert from -> to, keeping only the cheapest parallel arc
+    void addArc(int from, int to, double weight, int middle) {
+        if (from == to) {
+            return;
+        }
+        for (auto& arc : out[from]) {
+            if (arc.node == to) {
+                if (weight < arc.weight) {
+                    arc.weight = weight;
+                    arc.middle = middle;
+                    for (auto& back : in[to]) {
+                        if (back.node == from) {
+                            back.weight = weight;
+                            back.middle = middle;
+                            break;
+                        }
+                    }
+                }
+                return;
+            }
+        }
+        out[from].push_back(WorkArc{to, weight, middle});
+        in[to].push_back(WorkArc{from, weight, middle});
+    }
+
+    // Shortcuts needed to contract v, found with one bounded witness search
+    // per incoming neighbour
+    void shortcutsFor(int v, SearchWorkspace& workspace, std::vector<Shortcut>& result) const {
+        result.clear();
+        for (const auto& inArc : in[v]) {
+            int u = inArc.node;
+            if (contracted[u]) {
+                continue;
+            }
+
+            double maxCost = -1.0;
+            size_t targets = 0;
+            for (const auto& outArc : out[v]) {
+                if (!contracted[outArc.node] && outArc.node != u) {
+                    maxCost = std::max(maxCost, inArc.weight + outArc.weight);
+                    targets++;
+                }
+            }
+            if (targets == 0) {
+                continue;
+            }
+
+            witnessSearch(u, v, maxCost, targets, workspace);
+
+            for (const auto& outArc : out[v]) {
+                int w = outArc.node;
+                if (contracted[w] || w == u) {
+                    continue;
+                }
+                double viaV = inArc.weight + outArc.weight;
+                if (workspace.distance(w) > viaV) {
+                    result.push_back(Shortcut{u, w, viaV});
+                }
+            }
+        }
+    }
+
+    // Dijkstra from source avoiding `avoid`, up to maxCost, the settle limit or
+    // until all of avoid's other out-neighbours are settled. Tentative
+    // distances left in the workspace are valid witness lengths.
+    void witnessSearch(int source, int avoid, double maxCost, size_t targets,
+                       SearchWorkspace& workspace) const {
+        workspace.prepare(out.size());
+        auto& heap = workspace.indexedHeap();
+        workspace.set(source, 0.0, -1);
+        heap.push(source, 0.0);
+
+        size_t settled = 0;
+        while (!heap.empty() && heap.topKey() <= maxCost && settled < settleLimit) {
+            int current = heap.pop();
+            workspace.close(current);
+            settled++;
+
+            if (current != source) {
+                for (const auto& arc : out[avoid]) {
+                    if (arc.node == current) {
+                        targets--;
+                        break;
+                    }
+                }
+                if (targets == 0) {
+                    break;
+                }
+            }
+
+            double d = workspace.distance(current);
+            for (const auto& arc : out[current]) {
+                if (arc.node == avoid || contracted[arc.node] || workspace.closed(arc.node)) {
+                    continue;
+                }
+                double nd = d + arc.weight;
+                if (nd < workspace.distance(arc.node)) {
+                    workspace.set(arc.node, nd, current);
+                    heap.pushOrDecrease(arc.node, nd);
+                }
+            }
+        }
+    }
+
+    // Edge difference plus contracted-neighbour count; lower contracts earlier
+    double priority(int v, SearchWorkspace& workspace, std::vector<Shortcut>& scratch) const {
+        shortcutsFor(v, workspace, scratch);
+        int removed = 0;
+        for (const auto& arc : out[v]) {
+            removed += contracted[arc.node] ? 0 : 1;
+        }
+        for (const auto& arc : in[v]) {
+            removed += contracted[arc.node] ? 0 : 1;
+        }
+        return static_cast<double>(scratch.size()) - removed + contractedNeighbors[v];
+    }
+
+    // True if (priority, id) of v is smaller than that of every uncontracted
+    // node within two hops; such nodes share no neighbours and can be
+    // contracted in the same round
+    bool locallyMinimal(int v, const std::vector<double>& priorities) const {
+        auto precedes = [&](int a, int b) {
+            return priorities[a] < priorities[b] || (priorities[a] == priorities[b] && a < b);
+        };
+        for (const auto* arcs : {&out[v], &in[v]}) {
+            for (const auto& arc : *arcs) {
+                int w = arc.node;
+                if (contracted[w]) {
+                    continue;
+                }
+                if (precedes(w, v)) {
+                    return false;
+                }
+                for (const auto* next : {&out[w], &in[w]}) {
+                    for (const auto& second : *next) {
+                        if (second.node != v && !contracted[second.node] &&
+                            precedes(second.node, v)) {
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    // Drop arcs to contracted nodes from v's lists
+    void prune(int v) {
+        auto dead = [&](const WorkArc& arc) { return contracted[arc.node] != 0; };
+        out[v].erase(std::remove_if(out[v].begin(), out[v].end(), dead), out[v].end());
+        in[v].erase(std::remove_if(in[v].begin(), in[v].end(), dead), in[v].end());
+    }
+};
+
+} // namespace
+
+ContractionHierarchy::ContractionHierarchy(const Graph& graph, const ContractionOptions& options)
+    : base(graph) {
+    build(options);
+}
+
+ContractionHierarchy::ContractionHierarchy(const CompactGraph& graph,
+                                           const ContractionOptions& options)
+    : base(graph) {
+    build(options);
+}
+
+void ContractionHierarchy::build(const ContractionOptions& options) {
+    const size_t n = base.nodeCount();
+    Contractor contractor(base, options.witnessSettleLimit);
+    ThreadPool pool(options.threads);
+
+    // Priorities: independent simulated contractions, one workspace per worker
+    std::vector<SearchWorkspace> workspaces(pool.size());
+    std::vector<std::vector<Shortcut>> scratch(pool.size());
+    std::vector<double> priorities(n);
+    pool.parallelFor(n, [&](size_t v, size_t worker) {
+        priorities[v] = contractor.priority(static_cast<int>(v), workspaces[worker],
+                                            scratch[worker]);
+    }, 64);
+
+    std::vector<std::vector<Arc>> up(n);
+    std::vector<std::vector<Arc>> down(n);
+    ranks.assign(n, -1);
+    shortcuts = 0;
+    int nextRank = 0;
+
+    std::vector<int> remaining(n);
+    for (size_t v = 0; v < n; v++) {
+        remaining[v] = static_cast<int>(v);
+    }
+    std::vector<char> selected(n, 0);
+    std::vector<int> round;
+    std::vector<std::vector<Shortcut>> added;
+    std::vector<int> neighbors;
+
+    while (!remaining.empty()) {
+        // Independent set: nodes whose priority is minimal within two hops.
+        // The global minimum always qualifies, and the choice depends only on
+        // priorities and ids, so the hierarchy is the same for any thread count.
+        pool.parallelFor(remaining.size(), [&](size_t i, size_t) {
+            selected[remaining[i]] = contractor.locallyMinimal(remaining[i], priorities);
+        }, 256);
+        round.clear();
+        for (int v : remaining) {
+            if (selected[v]) {
+                round.push_back(v);
+                selected[v] = 0;
+            }
+        }
+        std::sort(round.begin(), round.end(), [&](int a, int b) {
+            return priorities[a] < priorities[b] || (priorities[a] == priorities[b] && a < b);
+        });
+
+        // Shortcuts for the whole round, on the pool. Marking the round
+        // contracted first keeps witness paths off the other nodes that
+        // disappear with it.
+        for (int v : round) {
+            contractor.contracted[v] = 1;
+        }
+        if (added.size() < round.size()) {
+            added.resize(round.size());
+        }
+        pool.parallelFor(round.size(), [&](size_t i, size_t worker) {
+            contractor.shortcutsFor(round[i], workspaces[worker], added[i]);
+        }, 16);
+
+        neighbors.clear();
+        for (size_t i = 0; i < round.size(); i++) {
+            int v = round[i];
+            for (const auto& arc : contractor.out[v]) {
+                if (!contractor.contracted[arc.node]) {
+                    up[v].push_back(Arc{arc.node, arc.weight, arc.middle});
+                }
+            }
+            for (const auto& arc : contractor.in[v]) {
+                if (!contractor.contracted[arc.node]) {
+                    down[v].push_back(Arc{arc.node, arc.weight, arc.middle});
+                }
+            }
+            for (const auto& s : added[i]) {
+                contractor.addArc(s.from, s.to, s.weight, v);
+            }
+            shortcuts += added[i].size();
+            ranks[v] = nextRank++;
+
+            // Neighbours lose an arc and gain a contracted neighbour; the
+            // round's neighbourhoods are disjoint
+            size_t first = neighbors.size();
+            for (const auto& arc : up[v]) neighbors.push_back(arc.node);
+            for (const auto& arc : down[v]) neighbors.push_back(arc.node);
+            std::sort(neighbors.begin() + first, neighbors.end());
+            neighbors.erase(std::unique(neighbors.begin() + first, neighbors.end()),
+                            neighbors.end());
+            for (size_t k = first; k < neighbors.size(); k++) {
+                contractor.contractedNeighbors[neighbors[k]]++;
+                contractor.prune(neighbors[k]);
+            }
+            contractor.out[v].clear();
+            contractor.in[v].clear();
+        }
+
+        pool.parallelFor(neighbors.size(), [&](size_t i, size_t worker) {
+            int w = neighbors[i];
+            priorities[w] = contractor.priority(w, workspaces[worker], scratch[worker]);
+        }, 16);
+        remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                       [&](int v) { return contractor.contracted[v] != 0; }),
+                        remaining.end());
+    }
+
+    // Flatten the upward / downward arc lists into CSR arrays
+    upOffsets.assign(n + 1, 0);
+    downOffsets.assign(n + 1, 0);
+    for (size_t v = 0; v < n; v++) {
+        upOffsets[v + 1] = upOffsets[v] + up[v].size();
+        downOffsets[v + 1] = downOffsets[v] + down[v].size();
+    }
+    upArcs.clear();
+    downArcs.clear();
+    upArcs.reserve(upOffsets[n]);
+    downArcs.reserve(downOffsets[n]);
+    for (size_t v = 0; v < n; v++) {
+        upArcs.insert(upArcs.end(), up[v].begin(), up[v].end());
+        downArcs.insert(downArcs.end(), down[v].begin(), down[v].end());
+    }
+}
+
+int ContractionHierarchy::rank(int id) const {
+    int v = base.indexOf(id);
+    return v < 0 ? -1 : ranks[v];
+}
+
+const ContractionHierarchy::Arc* ContractionHierarchy::findUp(int from, int to) const {
+    for (size_t a = upOffsets[from]; a < upOffsets[from + 1]; a++) {
+        if (upArcs[a].node == to) {
+            return &upArcs[a];
+        }
+    }
+    return nullptr;
+}
+
+const ContractionHierarchy::Arc* ContractionHierarchy::findDown(int from, int to) const {
+    // Arc from -> to where rank(from) > rank(to) is stored in down[to]
+    for (size_t a = downOffsets[to]; a < downOffsets[to + 1]; a++) {
+        if (downArcs[a].node == from) {
+            return &downArcs[a];
+        }
+    }
+    return nullptr;
+}
+
+void ContractionHierarchy::unpack(int from, int to, int middle, std::vector<int>& path) const {
+    // Iterative in-order expansion; appends every node after `from` up to `to`
+    struct Pending {
+        int from;
+        int to;
+        int middle;
+    };
+    std::vector<Pending> stack{Pending{from, to, middle}};
+    while (!stack.empty()) {
+        Pending p = stack.back();
+        stack.pop_back();
+        if (p.middle < 0) {
+            path.push_back(base.idOf(p.to));
+            continue;
+        }
+        // Both halves end at the lower-ranked middle node
+        const Arc* first = findDown(p.from, p.middle);
+        const Arc* second = findUp(p.middle, p.to);
+        stack.push_back(Pending{p.middle, p.to, second->middle});
+        stack.push_back(Pending{p.from, p.middle, first->middle});
+    }
+}
+
+PathResult ContractionHierarchy::search(int startId, int goalId) const {
+    return search(startId, goalId, SearchWorkspace::local(0), SearchWorkspace::local(1));
+}
+
+PathResult ContractionHierarchy::search(int startId, int goalId,
+                                        SearchWorkspace& forward,
+                                        SearchWorkspace& backward) const {
+    int start = base.indexOf(startId);
+    int goal = base.indexOf(goalId);
+    if (start < 0 || goal < 0 || !base.mayReach(start, goal)) {
+        return PathResult();
+    }
+
+    const size_t n = base.nodeCount();
+    forward.prepare(n);
+    backward.prepare(n);
+    auto& forwardHeap = forward.indexedHeap();
+    auto& backwardHeap = backward.indexedHeap();
+
+    forward.set(start, 0.0, -1);
+    forwardHeap.push(start, 0.0);
+    backward.set(goal, 0.0, -1);
+    backwardHeap.push(goal, 0.0);
+
+    double mu = std::numeric_limits<double>::infinity();
+    int meet = -1;
+    size_t nodesExplored = 0;
+
+    while (true) {
+        bool forwardDone = forwardHeap.empty() || forwardHeap.topKey() >= mu;
+        bool backwardDone = backwardHeap.empty() || backwardHeap.topKey() >= mu;
+        if (forwardDone && backwardDone) {
+            break;
+        }
+        bool goForward = !forwardDone &&
+            (backwardDone || forwardHeap.topKey() <= backwardHeap.topKey());
+
+        SearchWorkspace& self = goForward ? forward : backward;
+        SearchWorkspace& other = goForward ? backward : forward;
+        auto& heap = goForward ? forwardHeap : backwardHeap;
+        const std::vector<size_t>& relaxOffsets = goForward ? upOffsets : downOffsets;
+        const std::vector<Arc>& relaxArcs = goForward ? upArcs : downArcs;
+        const std::vector<size_t>& stallOffsets = goForward ? downOffsets : upOffsets;
+        const std::vector<Arc>& stallArcs = goForward ? downArcs : upArcs;
+
+        int v = heap.pop();
+        self.close(v);
+        nodesExplored++;
+
+        double dv = self.distance(v);
+        double through = dv + other.distance(v);
+        if (through < mu) {
+            mu = through;
+            meet = v;
+        }
+
+        // Stall-on-demand: a higher node already reaches v more cheaply
+        bool stalled = false;
+        for (size_t a = stallOffsets[v]; a < stallOffsets[v + 1]; a++) {
+            if (self.distance(stallArcs[a].node) + stallArcs[a].weight < dv) {
+                stalled = true;
+                break;
+            }
+        }
+        if (stalled) {
+            continue;
+        }
+
+        for (size_t a = relaxOffsets[v]; a < relaxOffsets[v + 1]; a++) {
+            int w = relaxArcs[a].node;
+            double dw = dv + relaxArcs[a].weight;
+            if (!self.closed(w) && dw < self.distance(w)) {
+                self.set(w, dw, v);
+                heap.pushOrDecrease(w, dw);
+            }
+        }
+    }
+
+    if (meet < 0) {
+        return PathResult();
+    }
+
+    // Upward chain start .. meet, then downward chain meet .. goal
+    std::vector<int> chain;
+    for (int node = meet; node != -1; node = forward.parent(node)) {
+        chain.push_back(node);
+    }
+    std::reverse(chain.begin(), chain.end());
+
+    std::vector<int> path{base.idOf(start)};
+    for (size_t i = 1; i < chain.size(); i++) {
+        unpack(chain[i - 1], chain[i], findUp(chain[i - 1], chain[i])->middle, path);
+    }
+    for (int node = meet; backward.parent(node) != -1; node = backward.parent(node)) {
+        int next = backward.parent(node);
+        unpack(node, next, findDown(node, next)->middle, path);
+    }
+
+    return PathResult(path, mu, nodesExplored);
+}
+
+void ContractionHierarchy::upwardSearch(int source, bool forward, SearchWorkspace& workspace,
+                                        std::vector<std::pair<int, double>>& settled) const {
+    const std::vector<size_t>& relaxOffsets = forward ? upOffsets : downOffsets;
+    const std::vector<Arc>& relaxArcs = forward ? upArcs : downArcs;
+    const std::vector<size_t>& stallOffsets = forward ? downOffsets : upOffsets;
+    const std::vector<Arc>& stallArcs = forward ? downArcs : upArcs;
+
+    workspace.prepare(base.nodeCount());
+    auto& heap = workspace.indexedHeap();
+    workspace.set(source, 0.0, -1);
+    heap.push(source, 0.0);
+
+    while (!heap.empty()) {
+        int v = heap.pop();
+        workspace.close(v);
+        double dv = workspace.distance(v);
+
+        bool stalled = false;
+        for (size_t a = stallOffsets[v]; a < stallOffsets[v + 1]; a++) {
+            if (workspace.distance(stallArcs[a].node) + stallArcs[a].weight < dv) {
+                stalled = true;
+                break;
+            }
+        }
+        if (stalled) {
+            continue;
+        }
+        settled.emplace_back(v, dv);
+
+        for (size_t a = relaxOffsets[v]; a < relaxOffsets[v + 1]; a++) {
+            int w = relaxArcs[a].node;
+            double dw = dv + relaxArcs[a].weight;
+            if (!workspace.closed(w) && dw < workspace.distance(w)) {
+                workspace.set(w, dw, v);
+                heap.pushOrDecrease(w, dw);
+            }
+        }
+    }
+}
+
+std::vector<double> ContractionHierarchy::distanceTable(const std::vector<int>& sourceIds,
+                                                        const std::vector<int>& targetIds,
+                                                        size_t threads) const {
+    const size_t n = base.nodeCount();
+    const size_t rows = sourceIds.size();
+    const size_t cols = targetIds.size();
+    std::vector<double> table(rows * cols, std::numeric_limits<double>::infinity());
+    if (rows == 0 || cols == 0) {
+        return table;
+    }
+
+    ThreadPool pool(threads);
+    std::vector<SearchWorkspace> workspaces(pool.size());
+
+    // Backward searches: spaces[j] holds (node, distance to target j)
+    std::vector<std::vector<std::pair<int, double>>> spaces(cols);
+    pool.parallelFor(cols, [&](size_t j, size_t worker) {
+        int target = base.indexOf(targetIds[j]);
+        if (target >= 0) {
+            upwardSearch(target, false, workspaces[worker], spaces[j]);
+        }
+    });
+
+    // Buckets in CSR form: node v -> (column, distance from v to target)
+    struct BucketEntry {
+        size_t column;
+        double dist;
+    };
+    std::vector<size_t> bucketOffsets(n + 1, 0);
+    for (const auto& space : spaces) {
+        for (const auto& entry : space) {
+            bucketOffsets[entry.first + 1]++;
+        }
+    }
+    for (size_t v = 0; v < n; v++) {
+        bucketOffsets[v + 1] += bucketOffsets[v];
+    }
+    std::vector<BucketEntry> buckets(bucketOffsets[n]);
+    std::vector<size_t> fill(bucketOffsets.begin(), bucketOffsets.end() - 1);
+    for (size_t j = 0; j < cols; j++) {
+        for (const auto& entry : spaces[j]) {
+            buckets[fill[entry.first]++] = BucketEntry{j, entry.second};
+        }
+        std::vector<std::pair<int, double>>().swap(spaces[j]);
+    }
+
+    // Forward searches scan the buckets of every settled node
+    std::vector<std::vector<std::pair<int, double>>> settled(pool.size());
+    pool.parallelFor(rows, [&](size_t i, size_t worker) {
+        int source = base.indexOf(sourceIds[i]);
+        if (source < 0) {
+            return;
+        }
+        auto& space = settled[worker];
+        space.clear();
+        upwardSearch(source, true, workspaces[worker], space);
+
+        double* row = &table[i * cols];
+        for (const auto& entry : space) {
+            for (size_t b = bucketOffsets[entry.first]; b < bucketOffsets[entry.first + 1]; b++) {
+                double d = entry.second + buckets[b].dist;
+                if (d < row[buckets[b].column]) {
+                    row[buckets[b].column] = d;
+                }
+            }
+        }
+    });
+
+    return table;
+}
+
+} // namespace sf
@@ -0,0 +1,260 @@
+#include "sf/delta_stepping.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace sf {
+
+// ShortestPathTree
+
+namespace {
+
+int denseIndex(const std::vector<int>& ids, int id) {
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    return it != ids.end() && *it == id ? static_cast<int>(it - ids.begin()) : -1;
+}
+
+} // namespace
+
+bool ShortestPathTree::reached(int id) const {
+    int v = denseIndex(ids, id);
+    return v >= 0 && distance[v] != std::numeric_limits<double>::infinity();
+}
+
+double ShortestPathTree::distanceTo(int id) const {
+    int v = denseIndex(ids, id);
+    return v < 0 ? std::numeric_limits<double>::infinity() : distance[v];
+}
+
+std::vector<int> ShortestPathTree::pathTo(int id) const {
+    std::vector<int> path;
+    if (!reached(id)) {
+        return path;
+    }
+    for (int node = id; node != -1; node = parent[denseIndex(ids, node)]) {
+        path.push_back(node);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+// DeltaStepping
+
+DeltaStepping::DeltaStepping(size_t threads, double delta) : pool(threads), delta(delta) {}
+
+double DeltaStepping::bucketWidth(const CompactGraph& graph) const {
+    if (delta > 0.0) {
+        return delta;
+    }
+    if (graph.edgeCount() == 0 || graph.maxEdgeWeight() <= 0.0) {
+        return 1.0;
+    }
+    double averageDegree = static_cast<double>(graph.edgeCount()) / graph.nodeCount();
+    return graph.maxEdgeWeight() / std::max(1.0, averageDegree);
+}
+
+size_t DeltaStepping::solve(const CompactGraph& graph, int source, int goal,
+                            std::vector<double>& dist, std::vector<int>& parent) {
+    const size_t n = graph.nodeCount();
+    const size_t owners = pool.size();
+    const size_t blockSize = (n + owners - 1) / owners;
+    const double width = bucketWidth(graph);
+    const double inf = std::numeric_limits<double>::infinity();
+
+    auto ownerOf = [&](int v) { return static_cast<size_t>(v) / blockSize; };
+    auto bucketOf = [&](double d) { return static_cast<size_t>(d / width); };
+
+    // Relaxing from bucket i reaches at most ceil(maxWeight / width) buckets
+    // ahead, so live entries fit in a ring of that many slots plus the
+    // current one; one spare slot absorbs rounding at bucket boundaries.
+    // Infinite weights never produce a request and do not count.
+    double heaviest = graph.maxEdgeWeight();
+    if (heaviest == inf) {
+        heaviest = 0.0;
+        for (size_t e = 0; e < graph.edgeCount(); e++) {
+            if (graph.edgeWeight(e) != inf) {
+                heaviest = std::max(heaviest, graph.edgeWeight(e));
+            }
+        }
+    }
+    const size_t slots = static_cast<size_t>(std::ceil(heaviest / width)) + 2;
+
+    dist.assign(n, inf);
+    parent.assign(n, -1);
+    std::vector<double> expandedAt(n, inf);   // dist at the node's last expansion
+    std::vector<size_t> settledIn(n, std::numeric_limits<size_t>::max());
+    std::vector<Owner> blocks(owners);
+    for (Owner& block : blocks) {
+        block.buckets.resize(slots);
+    }
+    std::vector<std::vector<std::vector<Request>>> requests(
+        owners, std::vector<std::vector<Request>>(owners));
+    std::vector<size_t> frontierOffsets(owners + 1);
+    std::vector<size_t> expandedBy(owners, 0);
+
+    dist[source] = 0.0;
+    blocks[ownerOf(source)].buckets[0].push_back(source);
+
+    // Turn the nodes in each block's list into requests over light or heavy
+    // edges, then let every owner apply the requests for its nodes
+    auto relax = [&](std::vector<int> Owner::*list, bool light) {
+        frontierOffsets[0] = 0;
+        for (size_t o = 0; o < owners; o++) {
+            frontierOffsets[o + 1] = frontierOffsets[o] + (blocks[o].*list).size();
+        }
+        pool.parallelFor(frontierOffsets[owners], [&](size_t i, size_t worker) {
+            size_t o = std::upper_bound(frontierOffsets.begin(), frontierOffsets.end(), i) -
+                       frontierOffsets.begin() - 1;
+            int v = (blocks[o].*list)[i - frontierOffsets[o]];
+            double dv = dist[v];
+            for (size_t e = graph.edgeBegin(v); e < graph.edgeEnd(v); e++) {
+                double w = graph.edgeWeight(e);
+                if ((w <= width) != light) {
+                    continue;
+                }
+                int target = graph.edgeTarget(e);
+                double nd = dv + w;
+                if (nd < dist[target]) {
+                    requests[worker][ownerOf(target)].push_back(Request{target, v, nd});
+                }
+            }
+        }, 256);
+
+        pool.parallelFor(owners, [&](size_t o, size_t) {
+            Owner& block = blocks[o];
+            for (size_t w = 0; w < owners; w++) {
+                for (const Request& r : requests[w][o]) {
+                    if (r.dist < dist[r.node]) {
+                        dist[r.node] = r.dist;
+                        parent[r.node] = r.parent;
+                        block.buckets[bucketOf(r.dist) % slots].push_back(r.node);
+                    }
+                }
+                requests[w][o].clear();
+            }
+        });
+    };
+
+    size_t current = 0;
+    while (true) {
+        // Smallest non-empty bucket index across blocks, within one turn of the ring
+        size_t next = std::numeric_limits<size_t>::max();
+        for (const Owner& block : blocks) {
+            for (size_t b = current; b < current + slots && b < next; b++) {
+                if (!block.buckets[b % slots].empty()) {
+                    next = b;
+                    break;
+                }
+            }
+        }
+        if (next == std::numeric_limits<size_t>::max()) {
+            break;
+        }
+        current = next;
+
+        // Light phases: re-expand the bucket until no node falls back into it
+        while (true) {
+            pool.parallelFor(owners, [&](size_t o, size_t) {
+                Owner& block = blocks[o];
+                std::vector<int>& bucket = block.buckets[current % slots];
+                block.frontier.clear();
+                for (int v : bucket) {
+                    // Skip stale entries and duplicates of an already expanded distance
+                    if (bucketOf(dist[v]) != current || expandedAt[v] == dist[v]) {
+                        continue;
+                    }
+                    expandedAt[v] = dist[v];
+                    block.frontier.push_back(v);
+                    expandedBy[o]++;
+                    if (settledIn[v] != current) {
+                        settledIn[v] = current;
+                        block.settled.push_back(v);
+                    }
+                }
+                bucket.clear();
+            });
+
+            bool empty = true;
+            for (const Owner& block : blocks) {
+                empty = empty && block.frontier.empty();
+            }
+            if (empty) {
+                break;
+            }
+            relax(&Owner::frontier, true);
+        }
+
+        if (goal >= 0 && dist[goal] != inf && bucketOf(dist[goal]) <= current) {
+            break;
+        }
+
+        relax(&Owner::settled, false);
+        for (Owner& block : blocks) {
+            block.settled.clear();
+        }
+        current++;
+    }
+
+    size_t nodesExplored = 0;
+    for (size_t count : expandedBy) {
+        nodesExplored += count;
+    }
+    return nodesExplored;
+}
+
+ShortestPathTree DeltaStepping::run(const CompactGraph& graph, int sourceId) {
+    ShortestPathTree tree;
+    tree.sourceId = sourceId;
+    tree.ids.resize(graph.nodeCount());
+    for (size_t v = 0; v < graph.nodeCount(); v++) {
+        tree.ids[v] = graph.idOf(static_cast<int>(v));
+    }
+
+    int source = graph.indexOf(sourceId);
+    if (source < 0) {
+        tree.distance.assign(graph.nodeCount(), std::numeric_limits<double>::infinity());
+        tree.parent.assign(graph.nodeCount(), -1);
+        return tree;
+    }
+
+    tree.nodesExplored = solve(graph, source, -1, tree.distance, tree.parent);
+    for (int& p : tree.parent) {
+        p = p < 0 ? -1 : graph.idOf(p);
+    }
+    return tree;
+}
+
+ShortestPathTree DeltaStepping::run(const Graph& graph, int sourceId) {
+    return run(graph.freeze(), sourceId);
+}
+
+PathResult DeltaStepping::search(const CompactGraph& graph, int startId, int goalId) {
+    int start = graph.indexOf(startId);
+    int goal = graph.indexOf(goalId);
+    if (start < 0 || goal < 0 || !graph.mayReach(start, goal)) {
+        return PathResult();
+    }
+
+    std::vector<double> dist;
+    std::vector<int> parent;
+    size_t nodesExplored = solve(graph, start, goal, dist, parent);
+    if (dist[goal] == std::numeric_limits<double>::infinity()) {
+        return PathResult();
+    }
+
+    std::vector<int> path;
+    for (int node = goal; node != -1; node = parent[node]) {
+        path.push_back(graph.idOf(node));
+    }
+    std::reverse(path.begin(), path.end());
+    return PathResult(path, dist[goal], nodesExplored);
+}
+
+PathResult DeltaStepping::search(const Graph& graph, int startId, int goalId) {
+    if (!graph.mayReach(startId, goalId)) {
+        return PathResult();
+    }
+    return search(graph.freeze(), startId, goalId);
+}
+
+} // namespace sf
@@ -0,0 +1,113 @@
+#include "sf/distance_matrix.h"
+#include "sf/search_workspace.h"
+#include "sf/thread_pool.h"
+
+namespace sf {
+
+template <typename T>
+DistanceMatrix<T> DistanceMatrix<T>::compute(const CompactGraph& graph,
+                                             const std::vector<int>& sources,
+                                             const std::vector<int>& targets, size_t threads) {
+    const size_t n = graph.nodeCount();
+    DistanceMatrix matrix(sources.size(), targets.size());
+    if (sources.empty() || targets.empty()) {
+        return matrix;
+    }
+
+    // Columns of every target node in CSR form; a node may be listed twice
+    std::vector<size_t> columnOffsets(n + 1, 0);
+    for (int id : targets) {
+        int v = graph.indexOf(id);
+        if (v >= 0) {
+            columnOffsets[v + 1]++;
+        }
+    }
+    std::vector<int> targetNodes;
+    for (size_t v = 0; v < n; v++) {
+        if (columnOffsets[v + 1] > 0) {
+            targetNodes.push_back(static_cast<int>(v));
+        }
+        columnOffsets[v + 1] += columnOffsets[v];
+    }
+    std::vector<size_t> columns(columnOffsets[n]);
+    std::vector<size_t> fill(columnOffsets.begin(), columnOffsets.end() - 1);
+    for (size_t j = 0; j < targets.size(); j++) {
+        int v = graph.indexOf(targets[j]);
+        if (v >= 0) {
+            columns[fill[v]++] = j;
+        }
+    }
+
+    ThreadPool pool(threads);
+    std::vector<SearchWorkspace> workspaces(pool.size());
+    pool.parallelFor(sources.size(), [&](size_t i, size_t worker) {
+        int source = graph.indexOf(sources[i]);
+        if (source < 0) {
+            return;
+        }
+        // Targets in other components stay at infinity without a search
+        size_t remaining = 0;
+        for (int v : targetNodes) {
+            remaining += graph.mayReach(source, v) ? 1 : 0;
+        }
+        if (remaining == 0) {
+            return;
+        }
+
+        SearchWorkspace& workspace = workspaces[worker];
+        workspace.prepare(n);
+        auto& heap = workspace.indexedHeap();
+        workspace.set(source, 0.0, -1);
+        heap.push(source, 0.0);
+
+        T* row = matrix.row(i);
+        while (!heap.empty()) {
+            int current = heap.pop();
+            workspace.close(current);
+            double d = workspace.distance(current);
+
+            if (columnOffsets[current] != columnOffsets[current + 1]) {
+                for (size_t c = columnOffsets[current]; c < columnOffsets[current + 1]; c++) {
+                    row[columns[c]] = static_cast<T>(d);
+                }
+                if (--remaining == 0) {
+                    break;
+                }
+            }
+
+            for (size_t e = graph.edgeBegin(current); e < graph.edgeEnd(current); e++) {
+                int next = graph.edgeTarget(e);
+                double nd = d + graph.edgeWeight(e);
+                if (!workspace.closed(next) && nd < workspace.distance(next)) {
+                    workspace.set(next, nd, current);
+                    heap.pushOrDecrease(next, nd);
+                }
+            }
+        }
+    });
+
+    return matrix;
+}
+
+template <typename T>
+DistanceMatrix<T> DistanceMatrix<T>::compute(const Graph& graph, const std::vector<int>& sources,
+                                             const std::vector<int>& targets, size_t threads) {
+    return compute(graph.freeze(), sources, targets, threads);
+}
+
+template <typename T>
+DistanceMatrix<T> DistanceMatrix<T>::compute(const ContractionHierarchy& hierarchy,
+                                             const std::vector<int>& sources,
+                                             const std::vector<int>& targets, size_t threads) {
+    std::vector<double> table = hierarchy.distanceTable(sources, targets, threads);
+    DistanceMatrix matrix(sources.size(), targets.size());
+    for (size_t k = 0; k < table.size(); k++) {
+        matrix.values[k] = static_cast<T>(table[k]);
+    }
+    return matrix;
+}
+
+template class DistanceMatrix<float>;
+template class DistanceMatrix<double>;
+
+} // namespace sf
@@ -1,104 +1,247 @@
 #include "sf/dynamic_search.h"
 #include "sf/informed_search.h"
+#include "sf/indexed_heap.h"
 #include <algorithm>
+#include <cmath>
+#include <stdexcept>
 
 namespace sf {
 
+namespace dynamic_internal {
+
+namespace {
+
+std::vector<double> weightsOf(const CompactGraph& graph) {
+    std::vector<double> weights(graph.edgeCount());
+    for (size_t e = 0; e < weights.size(); e++) {
+        weights[e] = graph.edgeWeight(e);
+    }
+    return weights;
+}
+
+} // namespace
+
+EdgeCostTable::EdgeCostTable(const CompactGraph& graph, const char* owner)
+    : compact(&graph), owner(owner), costs(weightsOf(graph)) {}
+
+EdgeCostTable::EdgeCostTable(const Graph& graph, const char* owner)
+    : owned(std::make_unique<CompactGraph>(graph)), compact(owned.get()), owner(owner),
+      costs(weightsOf(*compact)) {}
+
+int EdgeCostTable::indexOf(int id) const {
+    int index = compact->indexOf(id);
+    if (index < 0) {
+        throw std::runtime_error(std::string(owner) + ": node not found: " + std::to_string(id));
+    }
+    return index;
+}
+
+double EdgeCostTable::cheapest(int from, int to) const {
+    double best = std::numeric_limits<double>::infinity();
+    for (size_t e = compact->edgeBegin(from); e < compact->edgeEnd(from); e++) {
+        if (compact->edgeTarget(e) == to) {
+            best = std::min(best, costs[e]);
+        }
+    }
+    return best;
+}
+
+double EdgeCostTable::set(int from, int to, double weight) {
+    double old = std::numeric_limits<double>::infinity();
+    bool found = false;
+    for (size_t e = compact->edgeBegin(from); e < compact->edgeEnd(from); e++) {
+        if (compact->edgeTarget(e) == to) {
+            old = std::min(old, costs[e]);
+            costs[e] = weight;
+            found = true;
+        }
+    }
+    if (!found) {
+        throw std::runtime_error(std::string(owner) + ": no edge " +
+                                 std::to_string(compact->idOf(from)) + " -> " +
+                                 std::to_string(compact->idOf(to)));
+    }
+    return old;
+}
+
+} // namespace dynamic_internal
+
 // 3.1 D* (Dynamic A*)
 PathResult DStar::search(const Graph& graph, int startId, int goalId,
-                         Heuristic heuristic) {
-    // Simplified D* implementation
-    // For full D*, we would need to maintain a priority queue of states
-    // and update rhs values dynamically
-    
-    // For now, use A* as the base algorithm
-    // In a real D* implementation, this would maintain state information
-    // and allow for incremental updates
-    
-    // This is a simplified version that demonstrates the concept
-    std::unordered_map<int, State> states;
-    
-    // Initialize all states
-    for (const auto& pair : graph.getNodes()) {
-        states[pair.first] = State();
+                         Heuristic /*heuristic*/) {
+    // D* expands by cost to the goal alone; the heuristic is not needed
+    if (!graph.mayReach(startId, goalId)) {
+        return PathResult();
     }
-    
-    // Set goal state
-    states[goalId].g = 0.0;
-    states[goalId].rhs = 0.0;
-    
-    // Priority queue for open list
-    using Pair = std::pair<double, int>;
-    auto cmp = [](const Pair& a, const Pair& b) { return a.first > b.first; };
-    std::priority_queue<Pair, std::vector<Pair>, decltype(cmp)> pq(cmp);
-    
-    pq.push({0.0, goalId});
-    
-    size_t nodesExplored = 0;
-    
-    while (!pq.empty()) {
-        auto [key, current] = pq.top();
-        pq.pop();
-        
-        if (states[current].visited) continue;
-        states[current].visited = true;
-        nodesExplored++;
-        
-        if (current == startId) {
-            // Reconstruct path
-            std::vector<int> path;
-            int node = startId;
-            path.push_back(node);
-            
-            while (node != goalId) {
-                const auto& neighbors = graph.getNeighbors(node);
-                double minCost = std::numeric_limits<double>::infinity();
-                int next = -1;
-                
-                for (const auto& edge : neighbors) {
-                    double cost = states[edge.to].g + edge.weight;
-                    if (cost < minCost) {
-                        minCost = cost;
-                        next = edge.to;
-                    }
-                }
-                
-                if (next == -1) break;
-                path.push_back(next);
-                node = next;
+    DStarPlanner planner(graph, startId, goalId);
+    return planner.plan();
+}
+
+PathResult DStar::update(const Graph& graph, int startId, int goalId,
+                         const std::vector<std::pair<int, int>>& removedEdges,
+                         Heuristic /*heuristic*/) {
+    // Without planner state the removals are applied before the first plan;
+    // DStarPlanner repairs only the affected region of an existing plan
+    if (!graph.mayReach(startId, goalId)) {
+        return PathResult();
+    }
+    DStarPlanner planner(graph, startId, goalId);
+    for (const auto& edge : removedEdges) {
+        if (graph.hasNode(edge.first) && graph.hasNode(edge.second) &&
+            planner.edgeCost(edge.first, edge.second) != std::numeric_limits<double>::infinity()) {
+            planner.removeEdge(edge.first, edge.second);
+        }
+    }
+    return planner.plan();
+}
+
+// 3.1.1 Persistent D* planner
+DStarPlanner::DStarPlanner(const CompactGraph& graph, int startId, int goalId)
+    : costs(graph, "DStarPlanner"), compact(&costs.graph()) {
+    initialize(startId, goalId);
+}
+
+DStarPlanner::DStarPlanner(const Graph& graph, int startId, int goalId)
+    : costs(graph, "DStarPlanner"), compact(&costs.graph()) {
+    initialize(startId, goalId);
+}
+
+void DStarPlanner::initialize(int startId, int goalId) {
+    startIndex = costs.indexOf(startId);
+    goalIndex = costs.indexOf(goalId);
+    const size_t n = compact->nodeCount();
+    h.assign(n, std::numeric_limits<double>::infinity());
+    next.assign(n, kNoEdge);
+    tags.assign(n, Tag::New);
+    open.resize(n);
+    insert(goalIndex, 0.0);
+}
+
+void DStarPlanner::insert(int node, double newH) {
+    double k = newH;
+    if (tags[node] == Tag::Open) {
+        k = std::min(open.key(node), newH);
+    } else if (tags[node] == Tag::Closed) {
+        k = std::min(h[node], newH);
+    }
+    h[node] = newH;
+    tags[node] = Tag::Open;
+    open.pushOrUpdate(node, k);
+}
+
+void DStarPlanner::processState() {
+    const double kOld = open.topKey();
+    const int x = open.pop();
+    tags[x] = Tag::Closed;
+
+    if (kOld < h[x]) {
+        // RAISE: try to lower x through successors that are already settled
+        // at or below kOld
+        for (size_t e = compact->edgeBegin(x); e < compact->edgeEnd(x); e++) {
+            int y = compact->edgeTarget(e);
+            if (tags[y] != Tag::New && h[y] <= kOld && h[x] > h[y] + costs[e]) {
+                next[x] = e;
+                h[x] = h[y] + costs[e];
             }
-            
-            return PathResult(path, states[startId].g, nodesExplored);
-        }
-        
-        const auto& neighbors = graph.getNeighbors(current);
-        for (const auto& edge : neighbors) {
-            if (states[edge.to].visited) continue;
-            
-            double newRhs = states[current].g + edge.weight;
-            if (newRhs < states[edge.to].rhs) {
-                states[edge.to].rhs = newRhs;
-                
-                if (states[edge.to].rhs < states[edge.to].g) {
-                    states[edge.to].g = states[edge.to].rhs;
-                    double h = heuristic(graph.getNode(edge.to), graph.getNode(startId));
-                    pq.push({states[edge.to].g + h, edge.to});
-                }
+        }
+    }
+
+    if (kOld == h[x]) {
+        // LOWER: x is final; offer it to every predecessor
+        for (size_t in = compact->reverseBegin(x); in < compact->reverseEnd(x); in++) {
+            int y = compact->reverseSource(in);
+            size_t e = compact->reverseEdge(in);
+            double through = h[x] + costs[e];
+            if (tags[y] == Tag::New || (next[y] == e && h[y] != through) ||
+                (next[y] != e && h[y] > through)) {
+                next[y] = e;
+                insert(y, through);
             }
         }
+        return;
+    }
+
+    // Still raised: pass the increase to the nodes pointing through x, and
+    // queue whichever side can lower the other
+    for (size_t in = compact->reverseBegin(x); in < compact->reverseEnd(x); in++) {
+        int y = compact->reverseSource(in);
+        size_t e = compact->reverseEdge(in);
+        double through = h[x] + costs[e];
+        if (tags[y] == Tag::New || (next[y] == e && h[y] != through)) {
+            next[y] = e;
+            insert(y, through);
+        } else if (next[y] != e && h[y] > through) {
+            insert(x, h[x]);
+        }
+    }
+    for (size_t e = compact->edgeBegin(x); e < compact->edgeEnd(x); e++) {
+        int y = compact->edgeTarget(e);
+        bool pointsToX = next[y] != kNoEdge && compact->edgeTarget(next[y]) == x;
+        if (!pointsToX && next[x] != e && h[x] > h[y] + costs[e] && tags[y] == Tag::Closed &&
+            h[y] > kOld) {
+            insert(y, h[y]);
+        }
     }
-    
-    return PathResult();
 }
 
-PathResult DStar::update(const Graph& graph, int startId, int goalId,
-                         const std::vector<std::pair<int, int>>& removedEdges,
-                         Heuristic heuristic) {
-    // In a real D* implementation, this would update the graph
-    // and only replan the affected parts of the path
-    
-    // For this simplified version, we recompute the entire path
-    return search(graph, startId, goalId, heuristic);
+PathResult DStarPlanner::plan() {
+    if (!compact->mayReach(startIndex, goalIndex)) {
+        return PathResult();
+    }
+    size_t expanded = 0;
+    while (!open.empty() && open.topKey() < h[startIndex]) {
+        processState();
+        expanded++;
+    }
+    totalExpanded += expanded;
+
+    PathResult none;
+    none.nodesExplored = expanded;
+    if (h[startIndex] == std::numeric_limits<double>::infinity()) {
+        return none;
+    }
+
+    // Follow the backpointers; once the open list's key reaches h(start)
+    // they describe a shortest path
+    std::vector<int> path = {compact->idOf(startIndex)};
+    double cost = 0.0;
+    int node = startIndex;
+    while (node != goalIndex) {
+        size_t e = next[node];
+        if (e == kNoEdge || costs[e] == std::numeric_limits<double>::infinity() ||
+            path.size() > compact->nodeCount()) {
+            return none;
+        }
+        cost += costs[e];
+        node = compact->edgeTarget(e);
+        path.push_back(compact->idOf(node));
+    }
+    return PathResult(path, cost, expanded);
+}
+
+void DStarPlanner::moveStart(int startId) {
+    // Keys do not depend on the start; plan() continues until the new start
+    // is settled
+    startIndex = costs.indexOf(startId);
+}
+
+double DStarPlanner::edgeCost(int fromId, int toId) const {
+    return costs.cheapest(costs.indexOf(fromId), costs.indexOf(toId));
+}
+
+void DStarPlanner::updateEdgeCost(int fromId, int toId, double weight) {
+    int u = costs.indexOf(fromId);
+    int v = costs.indexOf(toId);
+    costs.set(u, v, weight);
+    // MODIFY-COST: re-open the settled end nearer the goal; expanding it
+    // re-derives h(u) through the changed edge
+    if (tags[v] == Tag::Closed) {
+        insert(v, h[v]);
+    }
+}
+
+void DStarPlanner::removeEdge(int fromId, int toId) {
+    updateEdgeCost(fromId, toId, std::numeric_limits<double>::infinity());
 }
 
 // 3.2 D* Lite
@@ -106,106 +249,356 @@ PathResult DStarLite::search(const Graph& graph, int startId, int goalId,
                              Heuristic heuristic) {
     // D* Lite is similar to D* but uses a different formulation
     // It's based on LPA* but works backwards from goal to start
-    
-    // Simplified implementation using A* as base
-    return AStar::search(graph, startId, goalId, heuristic);
+    if (!graph.mayReach(startId, goalId)) {
+        return PathResult();
+    }
+    DStarLitePlanner planner(graph, startId, goalId, heuristic);
+    return planner.plan();
 }
 
 PathResult DStarLite::update(const Graph& graph, int startId, int goalId,
                              const std::vector<std::pair<int, int>>& changedEdges,
                              Heuristic heuristic) {
-    // In a real D* Lite implementation, this would update only
-    // the affected parts of the search tree
-    
-    return search(graph, startId, goalId, heuristic);
+    // Without planner state the changes are applied before the first plan;
+    // DStarLitePlanner replans only the affected vertices
+    if (!graph.mayReach(startId, goalId)) {
+        return PathResult();
+    }
+    DStarLitePlanner planner(graph, startId, goalId, heuristic);
+    for (const auto& edge : changedEdges) {
+        if (graph.hasNode(edge.first) && graph.hasNode(edge.second) &&
+            planner.edgeCost(edge.first, edge.second) != std::numeric_limits<double>::infinity()) {
+            planner.updateEdgeCost(edge.first, edge.second,
+                                   std::numeric_limits<double>::infinity());
+        }
+    }
+    return planner.plan();
 }
 
-// 3.3 LPA* (Lifelong Planning A*)
-PathResult LPAStar::search(const Graph& graph, int startId, int goalId,
-                           Heuristic heuristic) {
-    // LPA* maintains g and rhs values for all nodes
-    // and updates them incrementally when the graph changes
-    
-    std::unordered_map<int, State> states;
-    
-    // Initialize all states
-    for (const auto& pair : graph.getNodes()) {
-        states[pair.first] = State();
-        states[pair.first].h = heuristic(graph.getNode(pair.first), 
-                                        graph.getNode(goalId));
+// 3.2.1 Persistent D* Lite planner
+DStarLitePlanner::DStarLitePlanner(const CompactGraph& graph, int startId, int goalId,
+                                   Heuristic heuristic)
+    : costs(graph, "DStarLitePlanner"), compact(&costs.graph()),
+      heuristic(std::move(heuristic)) {
+    initialize(startId, goalId);
+}
+
+DStarLitePlanner::DStarLitePlanner(const Graph& graph, int startId, int goalId,
+                                   Heuristic heuristic)
+    : costs(graph, "DStarLitePlanner"), compact(&costs.graph()),
+      heuristic(std::move(heuristic)) {
+    initialize(startId, goalId);
+}
+
+void DStarLitePlanner::initialize(int startId, int goalId) {
+    startIndex = costs.indexOf(startId);
+    goalIndex = costs.indexOf(goalId);
+    const size_t n = compact->nodeCount();
+    g.assign(n, std::numeric_limits<double>::infinity());
+    rhs.assign(n, std::numeric_limits<double>::infinity());
+    open.resize(n);
+    rhs[goalIndex] = 0.0;
+    open.push(goalIndex, calculateKey(goalIndex));
+}
+
+double DStarLitePlanner::h(int from, int to) const {
+    return heuristic(compact->node(from), compact->node(to));
+}
+
+DStarLitePlanner::Key DStarLitePlanner::calculateKey(int node) const {
+    double m = std::min(g[node], rhs[node]);
+    return Key(m + h(startIndex, node) + km, m);
+}
+
+double DStarLitePlanner::lookahead(int node) const {
+    double best = std::numeric_limits<double>::infinity();
+    for (size_t e = compact->edgeBegin(node); e < compact->edgeEnd(node); e++) {
+        best = std::min(best, costs[e] + g[compact->edgeTarget(e)]);
     }
-    
-    // Set goal state
-    states[goalId].g = 0.0;
-    states[goalId].rhs = 0.0;
-    
-    // Priority queue for open list
-    using Pair = std::pair<double, int>;
-    auto cmp = [](const Pair& a, const Pair& b) { return a.first > b.first; };
-    std::priority_queue<Pair, std::vector<Pair>, decltype(cmp)> pq(cmp);
-    
-    pq.push({0.0, goalId});
-    
-    size_t nodesExplored = 0;
-    
-    while (!pq.empty()) {
-        auto [key, current] = pq.top();
-        pq.pop();
-        
-        if (current == startId && states[startId].rhs == states[startId].g) {
-            // Path found
-            std::vector<int> path;
-            int node = startId;
-            path.push_back(node);
-            
-            while (node != goalId) {
-                const auto& neighbors = graph.getNeighbors(node);
-                double minCost = std::numeric_limits<double>::infinity();
-                int next = -1;
-                
-                for (const auto& edge : neighbors) {
-                    double cost = states[edge.to].g + edge.weight;
-                    if (cost < minCost) {
-                        minCost = cost;
-                        next = edge.to;
-                    }
+    return best;
+}
+
+void DStarLitePlanner::updateVertex(int node) {
+    if (g[node] != rhs[node]) {
+        open.pushOrUpdate(node, calculateKey(node));
+    } else if (open.contains(node)) {
+        open.remove(node);
+    }
+}
+
+size_t DStarLitePlanner::computeShortestPath() {
+    size_t expanded = 0;
+    while (!open.empty() &&
+           (open.topKey() < calculateKey(startIndex) || rhs[startIndex] > g[startIndex])) {
+        int u = open.top();
+        Key oldKey = open.topKey();
+        Key newKey = calculateKey(u);
+        if (oldKey < newKey) {
+            // Queued before km grew: re-key instead of expanding
+            open.update(u, newKey);
+            continue;
+        }
+        expanded++;
+        if (g[u] > rhs[u]) {
+            // Overconsistent: settle u and offer it to its predecessors
+            g[u] = rhs[u];
+            open.remove(u);
+            for (size_t in = compact->reverseBegin(u); in < compact->reverseEnd(u); in++) {
+                int s = compact->reverseSource(in);
+                if (s != goalIndex) {
+                    rhs[s] = std::min(rhs[s], costs[compact->reverseEdge(in)] + g[u]);
                 }
-                
-                if (next == -1) break;
-                path.push_back(next);
-                node = next;
+                updateVertex(s);
             }
-            
-            return PathResult(path, states[startId].g, nodesExplored);
-        }
-        
-        nodesExplored++;
-        
-        const auto& neighbors = graph.getNeighbors(current);
-        for (const auto& edge : neighbors) {
-            double newRhs = states[current].g + edge.weight;
-            if (newRhs < states[edge.to].rhs) {
-                states[edge.to].rhs = newRhs;
-                
-                if (states[edge.to].rhs < states[edge.to].g) {
-                    states[edge.to].g = states[edge.to].rhs;
-                    double key = states[edge.to].g + states[edge.to].h;
-                    pq.push({key, edge.to});
+        } else {
+            // Underconsistent: raise u and re-derive everything that used it
+            double oldG = g[u];
+            g[u] = std::numeric_limits<double>::infinity();
+            for (size_t in = compact->reverseBegin(u); in < compact->reverseEnd(u); in++) {
+                int s = compact->reverseSource(in);
+                if (s != goalIndex && rhs[s] == costs[compact->reverseEdge(in)] + oldG) {
+                    rhs[s] = lookahead(s);
                 }
+                updateVertex(s);
+            }
+            if (u != goalIndex) {
+                rhs[u] = lookahead(u);
             }
+            updateVertex(u);
         }
     }
+    totalExpanded += expanded;
+    return expanded;
+}
+
+PathResult DStarLitePlanner::plan() {
+    if (!compact->mayReach(startIndex, goalIndex)) {
+        return PathResult();
+    }
+    size_t expanded = computeShortestPath();
+    PathResult none;
+    none.nodesExplored = expanded;
+    if (rhs[startIndex] == std::numeric_limits<double>::infinity()) {
+        return none;
+    }
+
+    // Follow the cheapest successor; consistent g values make this a shortest path
+    std::vector<int> path = {compact->idOf(startIndex)};
+    double cost = 0.0;
+    int node = startIndex;
+    while (node != goalIndex) {
+        double best = std::numeric_limits<double>::infinity();
+        size_t via = 0;
+        for (size_t e = compact->edgeBegin(node); e < compact->edgeEnd(node); e++) {
+            double value = costs[e] + g[compact->edgeTarget(e)];
+            if (value < best) {
+                best = value;
+                via = e;
+            }
+        }
+        if (best == std::numeric_limits<double>::infinity() ||
+            path.size() > compact->nodeCount()) {
+            return none;
+        }
+        cost += costs[via];
+        node = compact->edgeTarget(via);
+        path.push_back(compact->idOf(node));
+    }
+    return PathResult(path, cost, expanded);
+}
+
+void DStarLitePlanner::moveStart(int startId) {
+    int next = costs.indexOf(startId);
+    km += h(startIndex, next);
+    startIndex = next;
+}
+
+double DStarLitePlanner::edgeCost(int fromId, int toId) const {
+    return costs.cheapest(costs.indexOf(fromId), costs.indexOf(toId));
+}
+
+void DStarLitePlanner::updateEdgeCost(int fromId, int toId, double weight) {
+    int u = costs.indexOf(fromId);
+    int v = costs.indexOf(toId);
+    double oldCost = costs.set(u, v, weight);
+    if (u == goalIndex) {
+        return;
+    }
+    if (weight < oldCost) {
+        rhs[u] = std::min(rhs[u], weight + g[v]);
+    } else if (rhs[u] == oldCost + g[v]) {
+        rhs[u] = lookahead(u);
+    }
+    updateVertex(u);
+}
+
+// 3.3 LPA* (Lifelong Planning A*)
+PathResult LPAStar::search(const Graph& graph, int startId, int goalId,
+                           Heuristic heuristic) {
+    // LPA* maintains g and rhs values for all nodes
+    // and updates them incrementally when the graph changes
     
-    return PathResult();
+    if (!graph.mayReach(startId, goalId)) {
+        return PathResult();
+    }
+    LPAStarPlanner planner(graph, startId, goalId, heuristic);
+    return planner.computeShortestPath();
 }
 
 PathResult LPAStar::update(const Graph& graph, int startId, int goalId,
                            const std::vector<int>& changedNodes,
                            Heuristic heuristic) {
-    // In a real LPA* implementation, this would update only
-    // the affected nodes and their neighbors
-    
-    return search(graph, startId, goalId, heuristic);
+    // Without planner state the changes are applied before the first search;
+    // LPAStarPlanner re-expands only the affected vertices
+    if (!graph.mayReach(startId, goalId)) {
+        return PathResult();
+    }
+    LPAStarPlanner planner(graph, startId, goalId, heuristic);
+    for (int id : changedNodes) {
+        if (graph.hasNode(id)) {
+            planner.notifyNodeBlocked(id);
+        }
+    }
+    return planner.computeShortestPath();
+}
+
+// 3.3.1 Persistent LPA* planner
+LPAStarPlanner::LPAStarPlanner(const CompactGraph& graph, int startId, int goalId,
+                               Heuristic heuristic)
+    : costs(graph, "LPAStarPlanner"), compact(&costs.graph()),
+      heuristic(std::move(heuristic)) {
+    initialize(startId, goalId);
+}
+
+LPAStarPlanner::LPAStarPlanner(const Graph& graph, int startId, int goalId,
+                               Heuristic heuristic)
+    : costs(graph, "LPAStarPlanner"), compact(&costs.graph()),
+      heuristic(std::move(heuristic)) {
+    initialize(startId, goalId);
+}
+
+void LPAStarPlanner::initialize(int startId, int goalId) {
+    startIndex = costs.indexOf(startId);
+    goalIndex = costs.indexOf(goalId);
+    const size_t n = compact->nodeCount();
+    blocked.assign(n, false);
+    g.assign(n, std::numeric_limits<double>::infinity());
+    rhs.assign(n, std::numeric_limits<double>::infinity());
+    hCache.assign(n, std::numeric_limits<double>::quiet_NaN());
+    open.resize(n);
+    rhs[startIndex] = 0.0;
+    open.push(startIndex, calculateKey(startIndex));
+}
+
+double LPAStarPlanner::cost(int from, size_t e, int to) const {
+    return blocked[from] || blocked[to] ? std::numeric_limits<double>::infinity() : costs[e];
+}
+
+double LPAStarPlanner::h(int node) {
+    if (std::isnan(hCache[node])) {
+        hCache[node] = heuristic(compact->node(node), compact->node(goalIndex));
+    }
+    return hCache[node];
+}
+
+LPAStarPlanner::Key LPAStarPlanner::calculateKey(int node) {
+    double m = std::min(g[node], rhs[node]);
+    return Key(m + h(node), m);
+}
+
+void LPAStarPlanner::updateVertex(int node) {
+    if (node != startIndex) {
+        double best = std::numeric_limits<double>::infinity();
+        for (size_t in = compact->reverseBegin(node); in < compact->reverseEnd(node); in++) {
+            int source = compact->reverseSource(in);
+            best = std::min(best, g[source] + cost(source, compact->reverseEdge(in), node));
+        }
+        rhs[node] = best;
+    }
+    if (g[node] != rhs[node]) {
+        open.pushOrUpdate(node, calculateKey(node));
+    } else if (open.contains(node)) {
+        open.remove(node);
+    }
+}
+
+PathResult LPAStarPlanner::computeShortestPath() {
+    if (!compact->mayReach(startIndex, goalIndex)) {
+        return PathResult();
+    }
+    size_t expanded = 0;
+    while (!open.empty() &&
+           (open.topKey() < calculateKey(goalIndex) || rhs[goalIndex] != g[goalIndex])) {
+        int u = open.pop();
+        expanded++;
+        if (g[u] > rhs[u]) {
+            g[u] = rhs[u];
+        } else {
+            g[u] = std::numeric_limits<double>::infinity();
+            updateVertex(u);
+        }
+        for (size_t e = compact->edgeBegin(u); e < compact->edgeEnd(u); e++) {
+            updateVertex(compact->edgeTarget(e));
+        }
+    }
+    totalExpanded += expanded;
+
+    PathResult none;
+    none.nodesExplored = expanded;
+    if (g[goalIndex] == std::numeric_limits<double>::infinity()) {
+        return none;
+    }
+
+    // Walk back along the cheapest predecessors
+    std::vector<int> path = {compact->idOf(goalIndex)};
+    double total = 0.0;
+    int node = goalIndex;
+    while (node != startIndex) {
+        double best = std::numeric_limits<double>::infinity();
+        size_t via = 0;
+        for (size_t in = compact->reverseBegin(node); in < compact->reverseEnd(node); in++) {
+            int source = compact->reverseSource(in);
+            double value = g[source] + cost(source, compact->reverseEdge(in), node);
+            if (value < best) {
+                best = value;
+                via = in;
+            }
+        }
+        if (best == std::numeric_limits<double>::infinity() ||
+            path.size() > compact->nodeCount()) {
+            return none;
+        }
+        total += costs[compact->reverseEdge(via)];
+        node = compact->reverseSource(via);
+        path.push_back(compact->idOf(node));
+    }
+    std::reverse(path.begin(), path.end());
+    return PathResult(path, total, expanded);
+}
+
+double LPAStarPlanner::edgeCost(int fromId, int toId) const {
+    int from = costs.indexOf(fromId);
+    int to = costs.indexOf(toId);
+    return blocked[from] || blocked[to] ? std::numeric_limits<double>::infinity()
+                                        : costs.cheapest(from, to);
+}
+
+void LPAStarPlanner::notifyEdgeChanged(int fromId, int toId, double weight) {
+    int u = costs.indexOf(fromId);
+    int v = costs.indexOf(toId);
+    costs.set(u, v, weight);
+    updateVertex(v);
+}
+
+void LPAStarPlanner::notifyNodeBlocked(int id, bool block) {
+    int v = costs.indexOf(id);
+    // cost() treats every edge at a blocked node as infinite, so an edge
+    // comes back at its notified cost once neither end is blocked
+    blocked[v] = block;
+    updateVertex(v);
+    for (size_t e = compact->edgeBegin(v); e < compact->edgeEnd(v); e++) {
+        updateVertex(compact->edgeTarget(e));
+    }
 }
 
 } // namespace sf
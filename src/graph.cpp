@@ -1,5 +1,7 @@
 #include "sf/graph.h"
+#include <algorithm>
 #include <stdexcept>
+#include <string>
 
 namespace sf {
 
@@ -8,18 +10,107 @@ void Graph::addNode(const Node& node) {
     if (adjacency.find(node.id) == adjacency.end()) {
         adjacency[node.id] = std::vector<Edge>();
     }
+    if (slots.find(node.id) == slots.end()) {
+        slots[node.id] = reach.addNode();
+    }
+    record(GraphChange::Type::NodeAdded, node.id, node.id, -1, 0.0, 0.0);
 }
 
-void Graph::addEdge(int from, int to, double weight) {
+EdgeHandle Graph::addEdge(int from, int to, double weight) {
     if (!hasNode(from) || !hasNode(to)) {
         throw std::runtime_error("Cannot add edge: nodes do not exist");
     }
-    adjacency[from].emplace_back(from, to, weight);
+    EdgeHandle handle = static_cast<EdgeHandle>(locations.size());
+    auto blocked = parked.find(from);
+    std::vector<Edge>& list = blocked != parked.end() ? blocked->second : adjacency[from];
+    locations.push_back(EdgeLocation{from, static_cast<int>(list.size())});
+    list.emplace_back(from, to, weight, handle);
+    reach.addEdge(slots[from], slots[to]);
+    record(GraphChange::Type::EdgeAdded, from, to, handle, weight, weight);
+    return handle;
+}
+
+std::pair<EdgeHandle, EdgeHandle> Graph::addEdgeUndirected(int from, int to, double weight) {
+    EdgeHandle forward = addEdge(from, to, weight);
+    return {forward, addEdge(to, from, weight)};
+}
+
+Edge& Graph::edgeAt(EdgeHandle handle) {
+    return const_cast<Edge&>(static_cast<const Graph*>(this)->getEdge(handle));
+}
+
+const Edge& Graph::getEdge(EdgeHandle handle) const {
+    if (!hasEdge(handle)) {
+        throw std::runtime_error("Edge not found: " + std::to_string(handle));
+    }
+    const EdgeLocation& location = locations[handle];
+    auto blocked = parked.find(location.from);
+    const std::vector<Edge>& list =
+        blocked != parked.end() ? blocked->second : adjacency.at(location.from);
+    return list[location.position];
+}
+
+bool Graph::hasEdge(EdgeHandle handle) const {
+    return handle >= 0 && static_cast<size_t>(handle) < locations.size() &&
+           locations[handle].position >= 0;
+}
+
+void Graph::setEdgeWeight(EdgeHandle handle, double weight) {
+    Edge& edge = edgeAt(handle);
+    double oldWeight = edge.weight;
+    edge.weight = weight;
+    record(GraphChange::Type::WeightChanged, edge.from, edge.to, handle, oldWeight, weight);
+}
+
+void Graph::removeEdge(EdgeHandle handle) {
+    Edge removed = edgeAt(handle);
+    EdgeLocation& location = locations[handle];
+    auto blocked = parked.find(location.from);
+    std::vector<Edge>& list = blocked != parked.end() ? blocked->second : adjacency[location.from];
+    if (static_cast<size_t>(location.position) + 1 < list.size()) {
+        list[location.position] = list.back();
+        locations[list[location.position].handle].position = location.position;
+    }
+    list.pop_back();
+    location.position = -1;
+    // The reachability index stays a valid over-approximation without the edge
+    record(GraphChange::Type::EdgeRemoved, removed.from, removed.to, handle, removed.weight,
+           removed.weight);
 }
 
-void Graph::addEdgeUndirected(int from, int to, double weight) {
-    addEdge(from, to, weight);
-    addEdge(to, from, weight);
+EdgeHandle Graph::findEdge(int from, int to) const {
+    auto blocked = parked.find(from);
+    const std::vector<Edge>& list =
+        blocked != parked.end() ? blocked->second : getNeighbors(from);
+    for (const auto& edge : list) {
+        if (edge.to == to) {
+            return edge.handle;
+        }
+    }
+    return -1;
+}
+
+void Graph::blockNode(int id, bool blocked) {
+    if (!hasNode(id)) {
+        throw std::runtime_error("Node not found: " + std::to_string(id));
+    }
+    if (blocked == isBlocked(id)) {
+        return;
+    }
+    // Swapping the vectors keeps every position, so the handles stay valid
+    if (blocked) {
+        parked[id].swap(adjacency[id]);
+    } else {
+        auto it = parked.find(id);
+        adjacency[id].swap(it->second);
+        parked.erase(it);
+    }
+    record(blocked ? GraphChange::Type::NodeBlocked : GraphChange::Type::NodeUnblocked, id, id,
+           -1, 0.0, 0.0);
+}
+
+bool Graph::isBlocked(int id) const {
+    return !parked.empty() && parked.find(id) != parked.end();
 }
 
 const Node& Graph::getNode(int id) const {
@@ -54,7 +145,13 @@ size_t Graph::nodeCount() const {
 size_t Graph::edgeCount() const {
     size_t count = 0;
     for (const auto& pair : adjacency) {
-        count += pair.second.size();
+        if (parked.empty()) {
+            count += pair.second.size();
+            continue;
+        }
+        for (const auto& edge : pair.second) {
+            count += isBlocked(edge.to) ? 0 : 1;
+        }
     }
     return count;
 }
@@ -68,9 +165,84 @@ std::vector<int> Graph::getNodeIds() const {
     return ids;
 }
 
+bool Graph::mayReach(int fromId, int toId) const {
+    auto from = slots.find(fromId);
+    auto to = slots.find(toId);
+    if (from == slots.end() || to == slots.end()) {
+        return false;
+    }
+    return reach.mayReach(from->second, to->second);
+}
+
+void Graph::indexReachability() {
+    std::vector<int> idOfSlot(slots.size());
+    for (const auto& [id, slot] : slots) {
+        idOfSlot[slot] = id;
+    }
+    std::vector<size_t> offsets(idOfSlot.size() + 1, 0);
+    std::vector<int> targets;
+    for (size_t slot = 0; slot < idOfSlot.size(); slot++) {
+        for (const auto& edge : getNeighbors(idOfSlot[slot])) {
+            targets.push_back(slots.at(edge.to));
+        }
+        // Parked edges come back on unblock without touching the index
+        auto blocked = parked.find(idOfSlot[slot]);
+        if (blocked != parked.end()) {
+            for (const auto& edge : blocked->second) {
+                targets.push_back(slots.at(edge.to));
+            }
+        }
+        offsets[slot + 1] = targets.size();
+    }
+    reach.build(offsets, targets);
+}
+
+void Graph::record(GraphChange::Type type, int from, int to, EdgeHandle edge,
+                   double oldWeight, double weight) {
+    currentVersion++;
+    if (logging) {
+        log.push_back(GraphChange{currentVersion, type, from, to, edge, oldWeight, weight});
+    }
+}
+
+void Graph::recordChanges(bool enabled) {
+    logging = enabled;
+    logStart = currentVersion;
+    log.clear();
+}
+
+std::vector<GraphChange> Graph::changesSince(uint64_t since) const {
+    if (!logging || since < logStart || since > currentVersion) {
+        throw std::runtime_error("Graph change log does not cover version " +
+                                 std::to_string(since));
+    }
+    // One entry per version, so the first wanted entry is found by offset
+    return std::vector<GraphChange>(log.begin() + (since - logStart), log.end());
+}
+
+void Graph::trimChanges(uint64_t upTo) {
+    if (!logging || upTo <= logStart) {
+        return;
+    }
+    upTo = std::min(upTo, currentVersion);
+    size_t count = std::min(static_cast<size_t>(upTo - logStart), log.size());
+    log.erase(log.begin(), log.begin() + count);
+    logStart = upTo;
+}
+
 void Graph::clear() {
     nodes.clear();
     adjacency.clear();
+    parked.clear();
+    locations.clear();
+    slots.clear();
+    reach.clear();
+    // Handles start again from 0, so consumers must rebuild rather than replay
+    record(GraphChange::Type::Cleared, -1, -1, -1, 0.0, 0.0);
+    if (logging) {
+        log.erase(log.begin(), log.end() - 1);
+        logStart = currentVersion - 1;
+    }
 }
 
 namespace heuristics {
@@ -1,248 +1,594 @@
 #include "sf/informed_search.h"
+#include "sf/search_engine.h"
+#include "compact_path.h"
+#include "bidirectional_search.h"
+#include "sf/thread_pool.h"
 #include <unordered_set>
 #include <unordered_map>
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
 
 namespace sf {
 
 // 2.1 Best-First Search (Heuristic)
 PathResult BestFirstSearch::search(const Graph& graph, int startId, int goalId,
                                    Heuristic heuristic) {
-    if (!graph.hasNode(startId) || !graph.hasNode(goalId)) {
+    engine::LazyHeapQueue pq;
+    engine::HashVisited visited;
+    return engine::withHeuristic(heuristic, [&](const auto& h) {
+        return engine::run<engine::GreedyOrder>(engine::GraphView(graph), pq, visited, h,
+                                                startId, goalId);
+    });
+}
+
+PathResult BestFirstSearch::search(const CompactGraph& graph, int startId, int goalId,
+                                   Heuristic heuristic) {
+    return search(graph, startId, goalId, heuristic, SearchWorkspace::local());
+}
+
+PathResult BestFirstSearch::search(const CompactGraph& graph, int startId, int goalId,
+                                   Heuristic heuristic, SearchWorkspace& workspace) {
+    engine::IndexedHeapQueue pq(workspace.indexedHeap());
+    engine::DenseVisited visited(workspace);
+    return engine::withHeuristic(heuristic, [&](const auto& h) {
+        return engine::run<engine::GreedyOrder>(engine::CompactGraphView(graph), pq, visited, h,
+                                                startId, goalId);
+    });
+}
+
+// 2.2 A* Algorithm
+PathResult AStar::search(const Graph& graph, int startId, int goalId,
+                         Heuristic heuristic) {
+    engine::LazyHeapQueue pq;
+    engine::HashVisited visited;
+    return engine::withHeuristic(heuristic, [&](const auto& h) {
+        return engine::run(engine::GraphView(graph), pq, visited, h, startId, goalId);
+    });
+}
+
+PathResult AStar::search(const CompactGraph& graph, int startId, int goalId,
+                         Heuristic heuristic) {
+    return search(graph, startId, goalId, heuristic, SearchWorkspace::local());
+}
+
+PathResult AStar::search(const CompactGraph& graph, int startId, int goalId,
+                         Heuristic heuristic, SearchWorkspace& workspace, QueuePolicy queue) {
+    engine::CompactGraphView view(graph);
+    engine::DenseVisited visited(workspace);
+    const double scale = graph.integerWeightScale();
+    
+    return engine::withHeuristic(heuristic, [&](const auto& h) {
+        switch (resolveQueuePolicy(queue, graph)) {
+        case QueuePolicy::RadixHeap: {
+            engine::IntegerQueue<RadixHeap> pq(workspace.radixHeap(), scale);
+            return engine::run(view, pq, visited, h, startId, goalId);
+        }
+        case QueuePolicy::BucketQueue: {
+            workspace.bucketQueue().reserveSpan(
+                static_cast<size_t>(graph.maxEdgeWeight() * scale));
+            engine::IntegerQueue<BucketQueue> pq(workspace.bucketQueue(), scale);
+            return engine::run(view, pq, visited, h, startId, goalId);
+        }
+        default: {
+            engine::IndexedHeapQueue pq(workspace.indexedHeap());
+            return engine::run(view, pq, visited, h, startId, goalId);
+        }
+        }
+    });
+}
+
+// 2.2.1 Weighted A*
+PathResult WeightedAStar::search(const Graph& graph, int startId, int goalId, double weight,
+                                 Heuristic heuristic) {
+    engine::LazyHeapQueue pq;
+    engine::HashVisited visited;
+    return engine::withHeuristic(heuristic, [&](const auto& h) {
+        using Weighted = engine::WeightedHeuristic<std::decay_t<decltype(h)>>;
+        return engine::run(engine::GraphView(graph), pq, visited, Weighted{h, weight},
+                           startId, goalId);
+    });
+}
+
+PathResult WeightedAStar::search(const CompactGraph& graph, int startId, int goalId,
+                                 double weight, Heuristic heuristic) {
+    return search(graph, startId, goalId, weight, heuristic, SearchWorkspace::local());
+}
+
+PathResult WeightedAStar::search(const CompactGraph& graph, int startId, int goalId,
+                                 double weight, Heuristic heuristic,
+                                 SearchWorkspace& workspace) {
+    engine::IndexedHeapQueue pq(workspace.indexedHeap());
+    engine::DenseVisited visited(workspace);
+    return engine::withHeuristic(heuristic, [&](const auto& h) {
+        using Weighted = engine::WeightedHeuristic<std::decay_t<decltype(h)>>;
+        return engine::run(engine::CompactGraphView(graph), pq, visited, Weighted{h, weight},
+                           startId, goalId);
+    });
+}
+
+// 2.2.2 ARA* (Anytime Repairing A*)
+PathResult ARAStar::search(const Graph& graph, int startId, int goalId,
+                           const ARAStarOptions& options, Heuristic heuristic) {
+    if (!graph.mayReach(startId, goalId)) {
         return PathResult();
     }
-    
-    std::unordered_map<int, double> hScore;
-    std::unordered_map<int, int> parent;
-    std::unordered_set<int> visited;
-    
-    // Priority queue: (heuristic, node)
-    using Pair = std::pair<double, int>;
-    auto cmp = [](const Pair& a, const Pair& b) { return a.first > b.first; };
-    std::priority_queue<Pair, std::vector<Pair>, decltype(cmp)> pq(cmp);
-    
-    // Initialize heuristic scores
-    for (const auto& pair : graph.getNodes()) {
-        hScore[pair.first] = heuristic(pair.second, graph.getNode(goalId));
+    return search(graph.freeze(), startId, goalId, options, heuristic);
+}
+
+PathResult ARAStar::search(const CompactGraph& graph, int startId, int goalId,
+                           const ARAStarOptions& options, Heuristic heuristic) {
+    return search(graph, startId, goalId, options, heuristic, SearchWorkspace::local());
+}
+
+PathResult ARAStar::search(const CompactGraph& graph, int startId, int goalId,
+                           const ARAStarOptions& options, Heuristic heuristic,
+                           SearchWorkspace& workspace) {
+    int start = graph.indexOf(startId);
+    int goal = graph.indexOf(goalId);
+    if (start < 0 || goal < 0 || !graph.mayReach(start, goal)) {
+        return PathResult();
     }
-    
-    parent[startId] = -1;
-    pq.push({hScore[startId], startId});
-    
+
+    const Node goalNode = graph.node(goal);
+    auto h = [&](int v) { return heuristic(graph.node(v), goalNode); };
+    auto expired = [&]() { return ARAStarOptions::Clock::now() >= options.deadline; };
+
+    workspace.prepare(graph.nodeCount());
+    IndexedDaryHeap<4>& open = workspace.indexedHeap();
+    std::vector<int> closedList;
+    std::vector<int> incons;     // closed nodes whose g improved; may repeat
+    std::vector<int> pending;    // open nodes between iterations
+
+    double epsilon = std::max(1.0, options.initialEpsilon);
+    const double goalH = h(goal);
+    workspace.set(start, 0.0, -1);
+    open.push(start, epsilon * h(start));
+
+    PathResult best;
     size_t nodesExplored = 0;
-    
-    while (!pq.empty()) {
-        auto [h, current] = pq.top();
-        pq.pop();
-        
-        if (visited.find(current) != visited.end()) {
-            continue;
-        }
-        visited.insert(current);
-        nodesExplored++;
-        
-        if (current == goalId) {
-            // Reconstruct path
-            std::vector<int> path;
-            int node = goalId;
-            while (node != -1) {
-                path.push_back(node);
-                node = parent[node];
-            }
-            std::reverse(path.begin(), path.end());
-            
-            // Calculate cost
-            double cost = 0.0;
-            for (size_t i = 1; i < path.size(); i++) {
-                const auto& neighbors = graph.getNeighbors(path[i-1]);
-                for (const auto& edge : neighbors) {
-                    if (edge.to == path[i]) {
-                        cost += edge.weight;
-                        break;
+    while (true) {
+        // ImprovePath: weighted A* until the goal's key is the smallest
+        bool timedOut = false;
+        while (!open.empty() && workspace.distance(goal) + epsilon * goalH > open.topKey()) {
+            if (nodesExplored % 64 == 0 && expired()) {
+                timedOut = true;
+                break;
+            }
+            int current = open.pop();
+            workspace.close(current);
+            closedList.push_back(current);
+            nodesExplored++;
+
+            double g = workspace.distance(current);
+            for (size_t e = graph.edgeBegin(current); e < graph.edgeEnd(current); e++) {
+                int next = graph.edgeTarget(e);
+                double tentative = g + graph.edgeWeight(e);
+                if (tentative < workspace.distance(next)) {
+                    workspace.set(next, tentative, current);
+                    if (workspace.closed(next)) {
+                        incons.push_back(next);
+                    } else {
+                        open.pushOrUpdate(next, tentative + epsilon * h(next));
                     }
                 }
             }
-            
-            return PathResult(path, cost, nodesExplored);
         }
-        
-        const auto& neighbors = graph.getNeighbors(current);
-        for (const auto& edge : neighbors) {
-            if (visited.find(edge.to) == visited.end()) {
-                parent[edge.to] = current;
-                pq.push({hScore[edge.to], edge.to});
+        double goalG = workspace.distance(goal);
+        if (timedOut || goalG == std::numeric_limits<double>::infinity()) {
+            break;
+        }
+        // Parents whose g improved after the goal was reached (INCONS) still
+        // lead to it, along a path cheaper than g(goal); lower g(goal) to it
+        double chain = compact_internal::pathCost(graph, workspace, goal);
+        if (chain < goalG) {
+            goalG = chain;
+            workspace.set(goal, goalG, workspace.parent(goal));
+        }
+
+        // Bound from the cheapest f = g + h among nodes not yet expanded
+        pending.clear();
+        while (!open.empty()) {
+            pending.push_back(open.pop());
+        }
+        double lower = std::numeric_limits<double>::infinity();
+        for (const std::vector<int>* list : {&pending, &incons}) {
+            for (int v : *list) {
+                lower = std::min(lower, workspace.distance(v) + h(v));
             }
         }
+        double bound = lower >= goalG ? 1.0 : std::min(epsilon, goalG / lower);
+
+        best = PathResult(compact_internal::reconstructPath(graph, workspace, goal), goalG,
+                          nodesExplored);
+        if (options.onSolution) {
+            options.onSolution(best, bound);
+        }
+        if (bound <= 1.0 || expired()) {
+            break;
+        }
+
+        // Next iteration: lower epsilon, reopen INCONS, rekey and forget CLOSED
+        epsilon = std::max(1.0, epsilon - options.epsilonStep);
+        for (int v : closedList) {
+            workspace.reopen(v);
+        }
+        closedList.clear();
+        for (const std::vector<int>* list : {&pending, &incons}) {
+            for (int v : *list) {
+                if (!open.contains(v)) {
+                    open.push(v, workspace.distance(v) + epsilon * h(v));
+                }
+            }
+        }
+        incons.clear();
     }
-    
-    return PathResult();
+
+    open.clear();
+    best.nodesExplored = nodesExplored;
+    return best;
 }
 
-// 2.2 A* Algorithm
-PathResult AStar::search(const Graph& graph, int startId, int goalId,
-                         Heuristic heuristic) {
-    if (!graph.hasNode(startId) || !graph.hasNode(goalId)) {
-        return PathResult();
-    }
-    
-    std::unordered_map<int, double> gScore;
-    std::unordered_map<int, double> fScore;
-    std::unordered_map<int, int> parent;
-    std::unordered_set<int> closedSet;
-    
-    // Priority queue: (fScore, node)
-    using Pair = std::pair<double, int>;
-    auto cmp = [](const Pair& a, const Pair& b) { return a.first > b.first; };
-    std::priority_queue<Pair, std::vector<Pair>, decltype(cmp)> pq(cmp);
+// 2.3 IDA* (Iterative Deepening A*)
+namespace idastar_internal {
+    // Direct-mapped table of the smallest g each node was entered with in the
+    // current iteration. A later arrival with no smaller g has no more slack
+    // below the bound, so its subtree holds nothing new. Slots are stamped
+    // with an iteration counter that keeps growing across searches, so a
+    // table is reused without clearing it.
+    class TranspositionTable {
+    public:
+        // Round entries up to a power of two (0 disables); resizing drops all slots
+        void reserve(size_t entries) {
+            size_t size = 1;
+            while (size < entries) {
+                size <<= 1;
+            }
+            if (slots.size() != (entries == 0 ? 0 : size)) {
+                slots.assign(entries == 0 ? 0 : size, Slot{});
+                mask = size - 1;
+            }
+        }
+        
+        // Retire every recorded entry in O(1)
+        void nextIteration() {
+            if (++stamp == 0) {
+                std::fill(slots.begin(), slots.end(), Slot{});
+                stamp = 1;
+            }
+        }
+        
+        // True if node was entered with g' <= g this iteration; otherwise records g
+        bool prune(int node, double g) {
+            if (slots.empty()) {
+                return false;
+            }
+            Slot& slot = slots[(static_cast<uint32_t>(node) * 2654435761u) & mask];
+            if (slot.node == node && slot.stamp == stamp && slot.g <= g) {
+                return true;
+            }
+            slot = Slot{node, stamp, g};
+            return false;
+        }
+        
+    private:
+        struct Slot {
+            int node = -1;
+            uint32_t stamp = 0;
+            double g = 0.0;
+        };
+        std::vector<Slot> slots;
+        size_t mask = 0;
+        uint32_t stamp = 0;
+    };
     
-    // Initialize
-    for (const auto& pair : graph.getNodes()) {
-        gScore[pair.first] = std::numeric_limits<double>::infinity();
-        fScore[pair.first] = std::numeric_limits<double>::infinity();
-    }
+    // Root of a depth-first search: the path from the start and its cost
+    struct Task {
+        std::vector<int> prefix;
+        double g;
+    };
     
-    gScore[startId] = 0.0;
-    fScore[startId] = heuristic(graph.getNode(startId), graph.getNode(goalId));
-    parent[startId] = -1;
-    pq.push({fScore[startId], startId});
+    struct Frame {
+        int node;
+        double g;
+        size_t edge;   // next out-edge to try
+    };
     
-    size_t nodesExplored = 0;
+    // Per-worker state of one iteration
+    struct alignas(64) Worker {
+        SearchWorkspace* workspace = nullptr;   // closed flags mark the current path
+        TranspositionTable* table = nullptr;
+        std::vector<Frame> stack;
+        size_t nodesExplored = 0;
+        double nextBound = std::numeric_limits<double>::infinity();
+    };
     
-    while (!pq.empty()) {
-        auto [f, current] = pq.top();
-        pq.pop();
-        
-        if (closedSet.find(current) != closedSet.end()) {
-            continue;
+    // Search below the task's last node with an explicit stack. Returns true
+    // and fills path / cost once the goal is reached within bound; otherwise
+    // lowers worker.nextBound to the smallest f that exceeded the bound.
+    template <typename H>
+    bool boundedSearch(const CompactGraph& graph, const H& heuristic, int goal,
+                       const Node& goalNode, const Task& task, double bound,
+                       const std::atomic<bool>& stop, Worker& worker,
+                       std::vector<int>& path, double& cost) {
+        SearchWorkspace& workspace = *worker.workspace;
+        workspace.prepare(graph.nodeCount());
+        for (int v : task.prefix) {
+            workspace.close(v);
         }
-        closedSet.insert(current);
-        nodesExplored++;
-        
-        if (current == goalId) {
-            // Reconstruct path
-            std::vector<int> path;
-            int node = goalId;
-            while (node != -1) {
-                path.push_back(node);
-                node = parent[node];
-            }
-            std::reverse(path.begin(), path.end());
-            return PathResult(path, gScore[goalId], nodesExplored);
+        const int root = task.prefix.back();
+        if (worker.table->prune(root, task.g)) {
+            return false;
         }
         
-        const auto& neighbors = graph.getNeighbors(current);
-        for (const auto& edge : neighbors) {
-            if (closedSet.find(edge.to) != closedSet.end()) {
+        std::vector<Frame>& stack = worker.stack;
+        stack.clear();
+        stack.push_back(Frame{root, task.g, graph.edgeBegin(root)});
+        size_t sinceCheck = 0;
+        
+        while (!stack.empty()) {
+            Frame& top = stack.back();
+            if (top.edge == graph.edgeEnd(top.node)) {
+                workspace.reopen(top.node);
+                stack.pop_back();
+                continue;
+            }
+            size_t e = top.edge++;
+            int next = graph.edgeTarget(e);
+            if (workspace.closed(next)) {
                 continue;
             }
             
-            double tentativeG = gScore[current] + edge.weight;
-            if (tentativeG < gScore[edge.to]) {
-                parent[edge.to] = current;
-                gScore[edge.to] = tentativeG;
-                fScore[edge.to] = tentativeG + heuristic(graph.getNode(edge.to), 
-                                                        graph.getNode(goalId));
-                pq.push({fScore[edge.to], edge.to});
+            double g = top.g + graph.edgeWeight(e);
+            worker.nodesExplored++;
+            double f = g + heuristic(graph.node(next), goalNode);
+            if (f > bound) {
+                worker.nextBound = std::min(worker.nextBound, f);
+                continue;
+            }
+            if (next == goal) {
+                path.assign(task.prefix.begin(), task.prefix.end() - 1);
+                for (const Frame& frame : stack) {
+                    path.push_back(frame.node);
+                }
+                path.push_back(goal);
+                cost = g;
+                return true;
+            }
+            if (worker.table->prune(next, g)) {
+                continue;
             }
+            if (++sinceCheck == 1024) {
+                sinceCheck = 0;
+                if (stop.load(std::memory_order_relaxed)) {
+                    return false;
+                }
+            }
+            workspace.close(next);
+            stack.push_back(Frame{next, g, graph.edgeBegin(next)});
         }
+        return false;
     }
     
-    return PathResult();
-}
-
-// 2.3 IDA* (Iterative Deepening A*)
-namespace idastar_internal {
-    struct IDAStarNode {
-        int id;
-        double g;
-        double f;
-        
-        IDAStarNode(int i, double gVal, double fVal) : id(i), g(gVal), f(fVal) {}
-    };
+    // Expand the search tree breadth-first until there are enough tasks for
+    // the pool. Returns true (with path / cost) if the goal lies within reach.
+    template <typename H>
+    bool splitRoot(const CompactGraph& graph, const H& heuristic, int goal,
+                   const Node& goalNode, int start, double bound, size_t minTasks,
+                   std::vector<Task>& tasks, Worker& worker,
+                   std::vector<int>& path, double& cost) {
+        tasks.assign(1, Task{{start}, 0.0});
+        std::vector<Task> next;
+        for (size_t depth = 0; depth < 16 && !tasks.empty() && tasks.size() < minTasks; depth++) {
+            next.clear();
+            for (const Task& task : tasks) {
+                int v = task.prefix.back();
+                for (size_t e = graph.edgeBegin(v); e < graph.edgeEnd(v); e++) {
+                    int target = graph.edgeTarget(e);
+                    if (std::find(task.prefix.begin(), task.prefix.end(), target) !=
+                        task.prefix.end()) {
+                        continue;
+                    }
+                    double g = task.g + graph.edgeWeight(e);
+                    worker.nodesExplored++;
+                    double f = g + heuristic(graph.node(target), goalNode);
+                    if (f > bound) {
+                        worker.nextBound = std::min(worker.nextBound, f);
+                        continue;
+                    }
+                    next.push_back(Task{task.prefix, g});
+                    next.back().prefix.push_back(target);
+                    if (target == goal) {
+                        path = next.back().prefix;
+                        cost = g;
+                        return true;
+                    }
+                }
+            }
+            tasks.swap(next);
+        }
+        return false;
+    }
     
-    PathResult searchRecursive(const Graph& graph, int current, int goalId,
-                              double g, double bound, Heuristic heuristic,
-                              std::unordered_map<int, int>& parent,
-                              std::unordered_set<int>& visited,
-                              size_t& nodesExplored) {
-        nodesExplored++;
-        
-        double h = heuristic(graph.getNode(current), graph.getNode(goalId));
-        double f = g + h;
-        
-        if (f > bound) {
+    // Without a pool the search runs on the calling thread with workspaces[0];
+    // with one, workspaces holds one entry per pool worker.
+    template <typename H>
+    PathResult search(const CompactGraph& graph, int startId, int goalId, const H& heuristic,
+                      size_t tableEntries, ThreadPool* pool, SearchWorkspace* workspaces) {
+        int start = graph.indexOf(startId);
+        int goal = graph.indexOf(goalId);
+        if (start < 0 || goal < 0 || !graph.mayReach(start, goal)) {
             return PathResult();
         }
+        const Node goalNode = graph.node(goal);
+        if (start == goal) {
+            return PathResult({startId}, 0.0, 1);
+        }
         
-        if (current == goalId) {
-            return PathResult(std::vector<int>(), g, nodesExplored);
+        std::vector<Worker> workers(pool ? pool->size() : 1);
+        for (size_t w = 0; w < workers.size(); w++) {
+            workers[w].workspace = &workspaces[w];
+        }
+        // One table per worker slot, kept by the calling thread between searches
+        thread_local std::vector<TranspositionTable> tables;
+        if (tables.size() < workers.size()) {
+            tables.resize(workers.size());
+        }
+        for (size_t w = 0; w < workers.size(); w++) {
+            tables[w].reserve(tableEntries);
+            workers[w].table = &tables[w];
         }
         
-        double minBound = std::numeric_limits<double>::infinity();
+        std::vector<Task> tasks;
+        std::vector<int> path;
+        double cost = 0.0;
+        std::mutex foundMutex;
+        size_t nodesExplored = 1;
+        double bound = heuristic(graph.node(start), goalNode);
         
-        const auto& neighbors = graph.getNeighbors(current);
-        for (const auto& edge : neighbors) {
-            if (visited.find(edge.to) != visited.end()) {
-                continue;
+        for (;;) {
+            std::atomic<bool> found(false);
+            for (Worker& worker : workers) {
+                worker.table->nextIteration();
+                worker.nodesExplored = 0;
+                worker.nextBound = std::numeric_limits<double>::infinity();
             }
             
-            visited.insert(edge.to);
-            parent[edge.to] = current;
-            
-            auto result = searchRecursive(graph, edge.to, goalId, g + edge.weight,
-                                         bound, heuristic, parent, visited, nodesExplored);
-            
-            if (result.found) {
-                return result;
+            if (!pool) {
+                tasks.assign(1, Task{{start}, 0.0});
+                found = boundedSearch(graph, heuristic, goal, goalNode, tasks[0], bound,
+                                      found, workers[0], path, cost);
+            } else if (splitRoot(graph, heuristic, goal, goalNode, start, bound,
+                                 4 * workers.size(), tasks, workers[0], path, cost)) {
+                found = true;
+            } else {
+                pool->parallelFor(tasks.size(), [&](size_t i, size_t w) {
+                    if (found.load(std::memory_order_relaxed)) {
+                        return;
+                    }
+                    std::vector<int> taskPath;
+                    double taskCost = 0.0;
+                    if (boundedSearch(graph, heuristic, goal, goalNode, tasks[i], bound,
+                                      found, workers[w], taskPath, taskCost)) {
+                        std::lock_guard<std::mutex> lock(foundMutex);
+                        if (!found.load(std::memory_order_relaxed)) {
+                            path.swap(taskPath);
+                            cost = taskCost;
+                            found.store(true, std::memory_order_relaxed);
+                        }
+                    }
+                });
             }
             
-            if (result.cost > 0 && result.cost < minBound) {
-                minBound = result.cost;
+            double nextBound = std::numeric_limits<double>::infinity();
+            for (const Worker& worker : workers) {
+                nodesExplored += worker.nodesExplored;
+                nextBound = std::min(nextBound, worker.nextBound);
             }
-            
-            visited.erase(edge.to);
+            if (found) {
+                for (int& v : path) {
+                    v = graph.idOf(v);
+                }
+                return PathResult(path, cost, nodesExplored);
+            }
+            if (nextBound == std::numeric_limits<double>::infinity()) {
+                return PathResult();
+            }
+            bound = nextBound;
         }
-        
-        return PathResult();
     }
 }
 
 PathResult IDAStar::search(const Graph& graph, int startId, int goalId,
                            Heuristic heuristic) {
-    if (!graph.hasNode(startId) || !graph.hasNode(goalId)) {
+    if (!graph.mayReach(startId, goalId)) {
+        return PathResult();
+    }
+    return search(graph.freeze(), startId, goalId, IDAStarOptions(), heuristic);
+}
+
+PathResult IDAStar::search(const CompactGraph& graph, int startId, int goalId,
+                           Heuristic heuristic) {
+    return search(graph, startId, goalId, heuristic, SearchWorkspace::local());
+}
+
+PathResult IDAStar::search(const CompactGraph& graph, int startId, int goalId,
+                           Heuristic heuristic, SearchWorkspace& workspace) {
+    return engine::withHeuristic(heuristic, [&](const auto& h) {
+        return idastar_internal::search(graph, startId, goalId, h,
+                                        IDAStarOptions().tableEntries, nullptr, &workspace);
+    });
+}
+
+PathResult IDAStar::search(const CompactGraph& graph, int startId, int goalId,
+                           const IDAStarOptions& options, Heuristic heuristic) {
+    const size_t threads = options.threads == 0 ? ThreadPool::defaultThreadCount()
+                                                : options.threads;
+    if (threads > 1) {
+        ParallelIDAStar parallel(threads, options.tableEntries);
+        return parallel.search(graph, startId, goalId, heuristic);
+    }
+    return engine::withHeuristic(heuristic, [&](const auto& h) {
+        return idastar_internal::search(graph, startId, goalId, h, options.tableEntries,
+                                        nullptr, &SearchWorkspace::local());
+    });
+}
+
+// 2.3.1 Parallel IDA*
+ParallelIDAStar::ParallelIDAStar(size_t threads, size_t tableEntries)
+    : pool(threads), tableEntries(tableEntries), workspaces(pool.size()) {}
+
+PathResult ParallelIDAStar::search(const CompactGraph& graph, int startId, int goalId,
+                                   Heuristic heuristic) {
+    return engine::withHeuristic(heuristic, [&](const auto& h) {
+        return idastar_internal::search(graph, startId, goalId, h, tableEntries,
+                                        pool.size() > 1 ? &pool : nullptr,
+                                        workspaces.data());
+    });
+}
+
+PathResult ParallelIDAStar::search(const Graph& graph, int startId, int goalId,
+                                   Heuristic heuristic) {
+    if (!graph.mayReach(startId, goalId)) {
+        return PathResult();
+    }
+    return search(graph.freeze(), startId, goalId, heuristic);
+}
+
+// 2.4 Bidirectional A*
+PathResult BidirectionalAStar::search(const Graph& graph, int startId, int goalId,
+                                      Heuristic heuristic) {
+    if (!graph.mayReach(startId, goalId)) {
+        return PathResult();
+    }
+    return search(graph.freeze(), startId, goalId, heuristic);
+}
+
+PathResult BidirectionalAStar::search(const CompactGraph& graph, int startId, int goalId,
+                                      Heuristic heuristic) {
+    return search(graph, startId, goalId, heuristic,
+                  SearchWorkspace::local(0), SearchWorkspace::local(1));
+}
+
+PathResult BidirectionalAStar::search(const CompactGraph& graph, int startId, int goalId,
+                                      Heuristic heuristic,
+                                      SearchWorkspace& forward, SearchWorkspace& backward) {
+    int start = graph.indexOf(startId);
+    int goal = graph.indexOf(goalId);
+    if (start < 0 || goal < 0 || !graph.mayReach(start, goal)) {
         return PathResult();
     }
     
-    double bound = heuristic(graph.getNode(startId), graph.getNode(goalId));
-    size_t nodesExplored = 0;
+    const Node startNode = graph.node(start);
+    const Node goalNode = graph.node(goal);
+    auto potential = [&](int v) {
+        Node node = graph.node(v);
+        return 0.5 * (heuristic(node, goalNode) - heuristic(startNode, node));
+    };
     
-    while (true) {
-        std::unordered_map<int, int> parent;
-        std::unordered_set<int> visited;
-        visited.insert(startId);
-        parent[startId] = -1;
-        
-        auto result = idastar_internal::searchRecursive(
-            graph, startId, goalId, 0.0, bound, heuristic, parent, visited, nodesExplored);
-        
-        if (result.found) {
-            // Reconstruct path
-            std::vector<int> path;
-            int node = goalId;
-            while (node != -1) {
-                path.push_back(node);
-                node = parent[node];
-            }
-            std::reverse(path.begin(), path.end());
-            return PathResult(path, result.cost, nodesExplored);
-        }
-        
-        if (result.cost == std::numeric_limits<double>::infinity()) {
-            return PathResult();
-        }
-        
-        bound = result.cost;
-    }
+    return bidirectional_internal::search(graph, start, goal, forward, backward, potential);
 }
 
 } // namespace sf
@@ -0,0 +1,64 @@
+#include "sf/kd_tree.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace sf {
+
+KdTree::KdTree(std::vector<Node> nodes) : points(std::move(nodes)) {
+    build(0, points.size(), 0);
+}
+
+void KdTree::build(size_t begin, size_t end, int axis) {
+    if (end - begin <= 1) {
+        return;
+    }
+    size_t mid = begin + (end - begin) / 2;
+    std::nth_element(points.begin() + begin, points.begin() + mid, points.begin() + end,
+                     [axis](const Node& a, const Node& b) {
+                         return axis == 0 ? a.x < b.x : a.y < b.y;
+                     });
+    build(begin, mid, 1 - axis);
+    build(mid + 1, end, 1 - axis);
+}
+
+const Node* KdTree::nearest(double x, double y, Metric metric, double& distance) const {
+    const Node* best = nullptr;
+    distance = std::numeric_limits<double>::infinity();
+    search(0, points.size(), 0, x, y, metric, best, distance);
+    return best;
+}
+
+void KdTree::search(size_t begin, size_t end, int axis, double x, double y, Metric metric,
+                    const Node*& best, double& bestDistance) const {
+    if (begin >= end) {
+        return;
+    }
+    size_t mid = begin + (end - begin) / 2;
+    const Node& point = points[mid];
+    double dx = point.x - x;
+    double dy = point.y - y;
+    double d = metric == Metric::Euclidean ? std::sqrt(dx * dx + dy * dy)
+                                           : std::abs(dx) + std::abs(dy);
+    if (d < bestDistance) {
+        bestDistance = d;
+        best = &point;
+    }
+
+    // Descend into the query's side first; the other side is only worth a
+    // look if the splitting line is closer than the best point so far
+    double split = axis == 0 ? dx : dy;
+    if (split > 0) {
+        search(begin, mid, 1 - axis, x, y, metric, best, bestDistance);
+        if (split < bestDistance) {
+            search(mid + 1, end, 1 - axis, x, y, metric, best, bestDistance);
+        }
+    } else {
+        search(mid + 1, end, 1 - axis, x, y, metric, best, bestDistance);
+        if (-split < bestDistance) {
+            search(begin, mid, 1 - axis, x, y, metric, best, bestDistance);
+        }
+    }
+}
+
+} // namespace sf
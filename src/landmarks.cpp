@@ -0,0 +1,345 @@
+#include "sf/landmarks.h"
+#include "sf/search_workspace.h"
+#include "sf/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace sf {
+
+namespace {
+
+const float kInf = std::numeric_limits<float>::infinity();
+
+// Upper bound on d / stored(d): stored values are rounded towards zero and
+// lose less than 2^-23 relative precision
+const double kSlack = 1.0 + std::ldexp(1.0, -22);
+
+// Full Dijkstra from source over outgoing (or incoming, if reverse) edges.
+// dist receives every distance; order, if given, the nodes in settle order.
+// Parent links stay in the workspace.
+void settleAll(const CompactGraph& graph, int source, bool reverse, SearchWorkspace& workspace,
+               std::vector<double>& dist, std::vector<int>* order = nullptr) {
+    const size_t n = graph.nodeCount();
+    dist.assign(n, std::numeric_limits<double>::infinity());
+    if (order) {
+        order->clear();
+    }
+
+    workspace.prepare(n);
+    auto& heap = workspace.indexedHeap();
+    workspace.set(source, 0.0, -1);
+    heap.push(source, 0.0);
+
+    while (!heap.empty()) {
+        int current = heap.pop();
+        workspace.close(current);
+        double d = workspace.distance(current);
+        dist[current] = d;
+        if (order) {
+            order->push_back(current);
+        }
+
+        size_t begin = reverse ? graph.reverseBegin(current) : graph.edgeBegin(current);
+        size_t end = reverse ? graph.reverseEnd(current) : graph.edgeEnd(current);
+        for (size_t e = begin; e < end; e++) {
+            int next = reverse ? graph.reverseSource(e) : graph.edgeTarget(e);
+            double nd = d + (reverse ? graph.reverseWeight(e) : graph.edgeWeight(e));
+            if (!workspace.closed(next) && nd < workspace.distance(next)) {
+                workspace.set(next, nd, current);
+                heap.pushOrDecrease(next, nd);
+            }
+        }
+    }
+}
+
+// Largest float not above d
+float roundDown(double d) {
+    float f = static_cast<float>(d);
+    if (static_cast<double>(f) > d) {
+        f = std::nextafter(f, 0.0f);
+    }
+    return f;
+}
+
+// Returns whether every distance was stored exactly
+bool storeColumn(std::vector<float>& table, size_t count, size_t landmark,
+                 const std::vector<double>& dist) {
+    bool exact = true;
+    for (size_t v = 0; v < dist.size(); v++) {
+        float f = roundDown(dist[v]);
+        table[v * count + landmark] = f;
+        exact = exact && static_cast<double>(f) == dist[v];
+    }
+    return exact;
+}
+
+// Non-landmark node with the largest distance from the landmarks so far.
+// Unreachable nodes count as infinitely far, so new components get covered.
+int farthestUncovered(const std::vector<double>& coverage, const std::vector<char>& isLandmark) {
+    int best = -1;
+    for (size_t v = 0; v < coverage.size(); v++) {
+        if (!isLandmark[v] && (best < 0 || coverage[v] > coverage[best])) {
+            best = static_cast<int>(v);
+        }
+    }
+    return best;
+}
+
+// Lower bound d(from, to) >= d(L, to) - d(L, from) over the forward columns
+// filled so far (only used to guide selection, so always widened)
+double forwardBound(const std::vector<float>& forward, size_t count, size_t filled,
+                    int from, int to) {
+    double best = 0.0;
+    for (size_t l = 0; l < filled; l++) {
+        float dFrom = forward[from * count + l];
+        float dTo = forward[to * count + l];
+        if (dFrom != kInf && dTo != kInf) {
+            best = std::max(best, dTo - dFrom * kSlack);
+        }
+    }
+    return best;
+}
+
+// Goldberg-Werneck avoid: grow a shortest-path tree from a random root, weigh
+// each node by how badly the current landmarks bound its distance, and walk
+// from the root into the heaviest landmark-free subtree down to a leaf.
+int avoidCandidate(const CompactGraph& graph, int root, const std::vector<float>& forward,
+                   size_t count, size_t filled, const std::vector<char>& isLandmark,
+                   SearchWorkspace& workspace, std::vector<double>& dist) {
+    std::vector<int> order;
+    settleAll(graph, root, false, workspace, dist, &order);
+
+    const size_t n = graph.nodeCount();
+    std::vector<double> size(n, 0.0);
+    std::vector<char> covered(n, 0);
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        int v = *it;
+        size[v] += dist[v] - forwardBound(forward, count, filled, root, v);
+        covered[v] |= isLandmark[v];
+        int parent = workspace.parent(v);
+        if (parent >= 0) {
+            covered[parent] |= covered[v];
+            size[parent] += size[v];
+        }
+    }
+
+    // Children lists of the tree in CSR form
+    std::vector<size_t> childOffsets(n + 1, 0);
+    for (int v : order) {
+        int parent = workspace.parent(v);
+        if (parent >= 0) {
+            childOffsets[parent + 1]++;
+        }
+    }
+    for (size_t v = 0; v < n; v++) {
+        childOffsets[v + 1] += childOffsets[v];
+    }
+    std::vector<int> children(childOffsets[n]);
+    std::vector<size_t> fill(childOffsets.begin(), childOffsets.end() - 1);
+    for (int v : order) {
+        int parent = workspace.parent(v);
+        if (parent >= 0) {
+            children[fill[parent]++] = v;
+        }
+    }
+
+    int node = root;
+    while (true) {
+        int next = -1;
+        for (size_t c = childOffsets[node]; c < childOffsets[node + 1]; c++) {
+            int child = children[c];
+            if (!covered[child] && (next < 0 || size[child] > size[next])) {
+                next = child;
+            }
+        }
+        if (next < 0) {
+            break;
+        }
+        node = next;
+    }
+    return isLandmark[node] ? -1 : node;
+}
+
+} // namespace
+
+double Landmarks::Tables::bound(int from, int to) const {
+    const float* forwardFrom = &forward[static_cast<size_t>(from) * count];
+    const float* forwardTo = &forward[static_cast<size_t>(to) * count];
+    const float* backwardFrom = &backward[static_cast<size_t>(from) * count];
+    const float* backwardTo = &backward[static_cast<size_t>(to) * count];
+
+    double best = 0.0;
+    for (size_t l = 0; l < count; l++) {
+        // d(u, t) >= d(L, t) - d(L, u)
+        if (forwardFrom[l] != kInf && forwardTo[l] != kInf) {
+            best = std::max(best, forwardTo[l] - forwardFrom[l] * slack);
+        }
+        // d(u, t) >= d(u, L) - d(t, L)
+        if (backwardFrom[l] != kInf && backwardTo[l] != kInf) {
+            best = std::max(best, backwardFrom[l] - backwardTo[l] * slack);
+        }
+    }
+    return best;
+}
+
+Landmarks::Landmarks(const Graph& graph, const LandmarkOptions& options)
+    : Landmarks(graph.freeze(), options) {}
+
+Landmarks::Landmarks(const CompactGraph& graph, const LandmarkOptions& options) {
+    const size_t n = graph.nodeCount();
+    const size_t count = std::min(options.count, n);
+
+    std::vector<int> landmarks;
+    std::vector<float> forward(n * count, kInf);
+    bool exact = true;
+    std::vector<char> isLandmark(n, 0);
+    std::vector<double> coverage(n, std::numeric_limits<double>::infinity());
+    std::vector<double> dist;
+    SearchWorkspace workspace;
+    std::mt19937 rng(options.seed);
+
+    // Landmark selection is inherently sequential; each pick's forward
+    // distances are kept as its table column
+    if (count > 0) {
+        int seedNode = static_cast<int>(rng() % n);
+        settleAll(graph, seedNode, false, workspace, dist);
+        for (size_t v = 0; v < n; v++) {
+            coverage[v] = std::isinf(dist[v]) ? 0.0 : dist[v];
+        }
+        int next = farthestUncovered(coverage, isLandmark);
+        std::fill(coverage.begin(), coverage.end(), std::numeric_limits<double>::infinity());
+
+        while (true) {
+            size_t l = landmarks.size();
+            landmarks.push_back(next);
+            isLandmark[next] = 1;
+            settleAll(graph, next, false, workspace, dist);
+            exact = storeColumn(forward, count, l, dist) && exact;
+            for (size_t v = 0; v < n; v++) {
+                coverage[v] = std::min(coverage[v], dist[v]);
+            }
+            if (landmarks.size() == count) {
+                break;
+            }
+
+            next = -1;
+            if (options.selection == LandmarkSelection::Avoid) {
+                int root = static_cast<int>(rng() % n);
+                next = avoidCandidate(graph, root, forward, count, landmarks.size(), isLandmark,
+                                      workspace, dist);
+            }
+            if (next < 0) {
+                next = farthestUncovered(coverage, isLandmark);
+            }
+        }
+    }
+
+    build(graph, std::move(landmarks), std::move(forward), count, exact, options.threads);
+}
+
+Landmarks::Landmarks(const CompactGraph& graph, const std::vector<int>& landmarkIds,
+                     size_t threads) {
+    std::vector<int> landmarks;
+    std::vector<char> seen(graph.nodeCount(), 0);
+    for (int id : landmarkIds) {
+        int v = graph.indexOf(id);
+        if (v >= 0 && !seen[v]) {
+            seen[v] = 1;
+            landmarks.push_back(v);
+        }
+    }
+    build(graph, std::move(landmarks), std::vector<float>(), 0, true, threads);
+}
+
+void Landmarks::build(const CompactGraph& graph, std::vector<int> landmarks,
+                      std::vector<float> forward, size_t filled, bool exact, size_t threads) {
+    const size_t n = graph.nodeCount();
+    const size_t count = landmarks.size();
+
+    auto result = std::make_shared<Tables>();
+    result->count = count;
+    result->forward = std::move(forward);
+    result->forward.resize(n * count, kInf);
+    result->backward.assign(n * count, kInf);
+
+    // One Dijkstra per missing (landmark, direction) column. Columns are
+    // disjoint, so workers write straight into the node-major tables.
+    std::vector<std::pair<size_t, bool>> tasks;
+    for (size_t l = 0; l < count; l++) {
+        if (l >= filled) {
+            tasks.emplace_back(l, false);
+        }
+        tasks.emplace_back(l, true);
+    }
+
+    ThreadPool pool(std::min(threads == 0 ? ThreadPool::defaultThreadCount() : threads,
+                             std::max<size_t>(tasks.size(), 1)));
+    std::vector<SearchWorkspace> workspaces(pool.size());
+    std::vector<std::vector<double>> rows(pool.size());
+    std::vector<char> inexact(pool.size(), 0);
+    pool.parallelFor(tasks.size(), [&](size_t task, size_t worker) {
+        size_t l = tasks[task].first;
+        bool reverse = tasks[task].second;
+        settleAll(graph, landmarks[l], reverse, workspaces[worker], rows[worker]);
+        if (!storeColumn(reverse ? result->backward : result->forward, count, l, rows[worker])) {
+            inexact[worker] = 1;
+        }
+    });
+    for (char flag : inexact) {
+        exact = exact && !flag;
+    }
+    result->slack = exact ? 1.0 : kSlack;
+
+    result->landmarks.reserve(count);
+    for (int v : landmarks) {
+        result->landmarks.push_back(graph.idOf(v));
+    }
+    result->index.reserve(n);
+    for (size_t v = 0; v < n; v++) {
+        result->index.emplace(graph.idOf(static_cast<int>(v)), static_cast<int>(v));
+    }
+    tables = std::move(result);
+}
+
+const std::vector<int>& Landmarks::landmarkIds() const {
+    static const std::vector<int> none;
+    return tables ? tables->landmarks : none;
+}
+
+double Landmarks::lowerBound(int fromId, int toId) const {
+    if (!tables) {
+        return 0.0;
+    }
+    auto from = tables->index.find(fromId);
+    auto to = tables->index.find(toId);
+    if (from == tables->index.end() || to == tables->index.end()) {
+        return 0.0;
+    }
+    return tables->bound(from->second, to->second);
+}
+
+Heuristic Landmarks::heuristic() const {
+    std::shared_ptr<const Tables> shared = tables;
+    if (!shared) {
+        return heuristics::zero;
+    }
+    return [shared](const Node& a, const Node& b) {
+        auto from = shared->index.find(a.id);
+        auto to = shared->index.find(b.id);
+        if (from == shared->index.end() || to == shared->index.end()) {
+            return 0.0;
+        }
+        return shared->bound(from->second, to->second);
+    };
+}
+
+size_t Landmarks::memoryBytes() const {
+    if (!tables) {
+        return 0;
+    }
+    return (tables->forward.size() + tables->backward.size()) * sizeof(float);
+}
+
+} // namespace sf
@@ -0,0 +1,147 @@
+#include "sf/multi_goal_search.h"
+#include "sf/kd_tree.h"
+#include "sf/search_engine.h"
+#include "compact_path.h"
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+namespace sf {
+
+namespace {
+
+// Multi-source A* that stops at the first settled goal; h(v) must be a lower
+// bound on the cost from v to the nearest goal
+template <typename H>
+MultiGoalResult run(const CompactGraph& graph, const std::vector<std::pair<int, double>>& starts,
+                    const std::vector<int>& goals, SearchWorkspace& workspace, H h) {
+    workspace.prepare(graph.nodeCount());
+    IndexedDaryHeap<4>& open = workspace.indexedHeap();
+    for (const auto& [start, offset] : starts) {
+        if (offset < workspace.distance(start)) {
+            workspace.set(start, offset, -1);
+            open.pushOrDecrease(start, offset + h(start));
+        }
+    }
+
+    MultiGoalResult best;
+    size_t nodesExplored = 0;
+    while (!open.empty()) {
+        int current = open.pop();
+        workspace.close(current);
+        nodesExplored++;
+
+        if (std::binary_search(goals.begin(), goals.end(), current)) {
+            std::vector<int> path = compact_internal::reconstructPath(graph, workspace, current);
+            best.startId = path.front();
+            best.goalId = path.back();
+            best.result = PathResult(path, workspace.distance(current), nodesExplored);
+            return best;
+        }
+
+        double g = workspace.distance(current);
+        for (size_t e = graph.edgeBegin(current); e < graph.edgeEnd(current); e++) {
+            int next = graph.edgeTarget(e);
+            if (workspace.closed(next)) {
+                continue;
+            }
+            double tentative = g + graph.edgeWeight(e);
+            if (tentative < workspace.distance(next)) {
+                workspace.set(next, tentative, current);
+                open.pushOrDecrease(next, tentative + h(next));
+            }
+        }
+    }
+    best.result.nodesExplored = nodesExplored;
+    return best;
+}
+
+} // namespace
+
+MultiGoalResult MultiGoalSearch::search(const Graph& graph, int startId,
+                                        const std::vector<int>& goalIds, Heuristic heuristic) {
+    return search(graph, std::vector<SearchStart>{{startId, 0.0}}, goalIds, heuristic);
+}
+
+MultiGoalResult MultiGoalSearch::search(const Graph& graph, const std::vector<SearchStart>& starts,
+                                        const std::vector<int>& goalIds, Heuristic heuristic) {
+    return search(graph.freeze(), starts, goalIds, heuristic);
+}
+
+MultiGoalResult MultiGoalSearch::search(const CompactGraph& graph, int startId,
+                                        const std::vector<int>& goalIds, Heuristic heuristic) {
+    return search(graph, std::vector<SearchStart>{{startId, 0.0}}, goalIds, heuristic);
+}
+
+MultiGoalResult MultiGoalSearch::search(const CompactGraph& graph,
+                                        const std::vector<SearchStart>& starts,
+                                        const std::vector<int>& goalIds, Heuristic heuristic) {
+    return search(graph, starts, goalIds, heuristic, SearchWorkspace::local());
+}
+
+MultiGoalResult MultiGoalSearch::search(const CompactGraph& graph,
+                                        const std::vector<SearchStart>& starts,
+                                        const std::vector<int>& goalIds, Heuristic heuristic,
+                                        SearchWorkspace& workspace) {
+    std::vector<std::pair<int, double>> sources;
+    for (const SearchStart& start : starts) {
+        int index = graph.indexOf(start.id);
+        if (index >= 0) {
+            sources.emplace_back(index, start.offset);
+        }
+    }
+    std::vector<int> goals;
+    for (int id : goalIds) {
+        int index = graph.indexOf(id);
+        if (index >= 0) {
+            goals.push_back(index);
+        }
+    }
+    std::sort(goals.begin(), goals.end());
+    goals.erase(std::unique(goals.begin(), goals.end()), goals.end());
+    // Goals no start can reach would only loosen the heuristic
+    goals.erase(std::remove_if(goals.begin(), goals.end(), [&](int goal) {
+        return std::none_of(sources.begin(), sources.end(), [&](const auto& source) {
+            return graph.mayReach(source.first, goal);
+        });
+    }), goals.end());
+    if (sources.empty() || goals.empty()) {
+        return MultiGoalResult();
+    }
+
+    std::vector<Node> goalNodes;
+    goalNodes.reserve(goals.size());
+    for (int goal : goals) {
+        goalNodes.push_back(graph.node(goal));
+    }
+
+    return engine::withHeuristic(heuristic, [&](const auto& base) {
+        using H = std::decay_t<decltype(base)>;
+        if constexpr (std::is_same_v<H, engine::ZeroHeuristic>) {
+            return run(graph, sources, goals, workspace, [](int) { return 0.0; });
+        } else if constexpr (std::is_same_v<H, engine::EuclideanHeuristic> ||
+                             std::is_same_v<H, engine::ManhattanHeuristic>) {
+            const KdTree tree(std::move(goalNodes));
+            const KdTree::Metric metric = std::is_same_v<H, engine::EuclideanHeuristic>
+                                              ? KdTree::Metric::Euclidean
+                                              : KdTree::Metric::Manhattan;
+            return run(graph, sources, goals, workspace, [&](int v) {
+                const Node& node = graph.node(v);
+                double distance;
+                tree.nearest(node.x, node.y, metric, distance);
+                return distance;
+            });
+        } else {
+            return run(graph, sources, goals, workspace, [&](int v) {
+                const Node& node = graph.node(v);
+                double lowest = std::numeric_limits<double>::infinity();
+                for (const Node& goal : goalNodes) {
+                    lowest = std::min(lowest, base(node, goal));
+                }
+                return lowest;
+            });
+        }
+    });
+}
+
+} // namespace sf
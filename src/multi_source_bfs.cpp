@@ -0,0 +1,147 @@
+#include "sf/multi_source_bfs.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace sf {
+
+// HopTable
+
+int HopTable::hopsTo(size_t row, int id) const {
+    auto it = std::lower_bound(columnIds.begin(), columnIds.end(), id);
+    if (row >= rows() || it == columnIds.end() || *it != id) {
+        return -1;
+    }
+    uint16_t hops = (*this)(row, it - columnIds.begin());
+    return hops == unreachable ? -1 : hops;
+}
+
+// MultiSourceBFS
+
+namespace {
+
+// One bit per source of the batch, Words 64-bit words per node; the fixed
+// word loops compile to vector operations for the wider batches
+template <size_t Words>
+void traverse(const CompactGraph& graph, HopTable& table, size_t first, size_t count,
+              std::vector<uint64_t>& seen, std::vector<uint64_t>& visit,
+              std::vector<uint64_t>& visitNext, std::vector<int>& frontier,
+              std::vector<int>& next) {
+    const size_t n = graph.nodeCount();
+
+    // visit / visitNext are all zero between passes, seen is cleared here
+    seen.assign(n * Words, 0);
+    visit.resize(n * Words, 0);
+    visitNext.resize(n * Words, 0);
+    frontier.clear();
+    next.clear();
+
+    for (size_t b = 0; b < count; b++) {
+        int s = graph.indexOf(table.sourceIds()[first + b]);
+        if (s < 0) {
+            continue;
+        }
+        uint64_t any = 0;
+        for (size_t i = 0; i < Words; i++) {
+            any |= visit[s * Words + i];
+        }
+        if (any == 0) {
+            frontier.push_back(s);
+        }
+        seen[s * Words + b / 64] |= uint64_t(1) << (b % 64);
+        visit[s * Words + b / 64] |= uint64_t(1) << (b % 64);
+        table.column(s)[first + b] = 0;
+    }
+
+    for (size_t level = 1; !frontier.empty(); level++) {
+        // Push each frontier node's source set to its neighbours
+        for (int v : frontier) {
+            const uint64_t* sources = &visit[v * Words];
+            for (size_t e = graph.edgeBegin(v); e < graph.edgeEnd(v); e++) {
+                int u = graph.edgeTarget(e);
+                const uint64_t* known = &seen[u * Words];
+                uint64_t* target = &visitNext[u * Words];
+                uint64_t old = 0;
+                uint64_t added = 0;
+                for (size_t i = 0; i < Words; i++) {
+                    uint64_t fresh = sources[i] & ~known[i];
+                    old |= target[i];
+                    added |= fresh;
+                    target[i] |= fresh;
+                }
+                if (old == 0 && added != 0) {
+                    next.push_back(u);
+                }
+            }
+        }
+
+        if (!next.empty() && level >= HopTable::unreachable) {
+            throw std::runtime_error("MultiSourceBFS: hop count exceeds 16-bit table");
+        }
+        for (int v : frontier) {
+            std::fill_n(&visit[v * Words], Words, 0);
+        }
+        for (int u : next) {
+            uint16_t* hops = table.column(u) + first;
+            for (size_t i = 0; i < Words; i++) {
+                uint64_t fresh = visitNext[u * Words + i];
+                visitNext[u * Words + i] = 0;
+                visit[u * Words + i] = fresh;
+                seen[u * Words + i] |= fresh;
+                for (; fresh != 0; fresh &= fresh - 1) {
+                    hops[i * 64 + __builtin_ctzll(fresh)] = static_cast<uint16_t>(level);
+                }
+            }
+        }
+        frontier.swap(next);
+        next.clear();
+    }
+}
+
+} // namespace
+
+MultiSourceBFS::MultiSourceBFS(size_t threads, size_t batchWidth)
+    : pool(threads), width(batchWidth) {
+    if (width != 64 && width != 128 && width != 256) {
+        throw std::runtime_error("MultiSourceBFS: batch width must be 64, 128 or 256");
+    }
+}
+
+void MultiSourceBFS::pass(const CompactGraph& graph, HopTable& table, size_t first,
+                          size_t count, Scratch& s) {
+    switch (width / 64) {
+        case 1:
+            traverse<1>(graph, table, first, count, s.seen, s.visit, s.visitNext, s.frontier,
+                        s.next);
+            break;
+        case 2:
+            traverse<2>(graph, table, first, count, s.seen, s.visit, s.visitNext, s.frontier,
+                        s.next);
+            break;
+        default:
+            traverse<4>(graph, table, first, count, s.seen, s.visit, s.visitNext, s.frontier,
+                        s.next);
+            break;
+    }
+}
+
+HopTable MultiSourceBFS::run(const CompactGraph& graph, const std::vector<int>& sourceIds) {
+    std::vector<int> ids(graph.nodeCount());
+    for (size_t v = 0; v < graph.nodeCount(); v++) {
+        ids[v] = graph.idOf(static_cast<int>(v));
+    }
+    HopTable table(sourceIds, std::move(ids));
+
+    const size_t batches = (sourceIds.size() + width - 1) / width;
+    std::vector<Scratch> scratch(pool.size());
+    pool.parallelFor(batches, [&](size_t batch, size_t worker) {
+        size_t first = batch * width;
+        pass(graph, table, first, std::min(width, sourceIds.size() - first), scratch[worker]);
+    });
+    return table;
+}
+
+HopTable MultiSourceBFS::run(const Graph& graph, const std::vector<int>& sourceIds) {
+    return run(graph.freeze(), sourceIds);
+}
+
+} // namespace sf
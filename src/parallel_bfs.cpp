@@ -0,0 +1,246 @@
+#include "sf/parallel_bfs.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace sf {
+
+// HopTree
+
+namespace {
+
+int denseIndex(const std::vector<int>& ids, int id) {
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    return it != ids.end() && *it == id ? static_cast<int>(it - ids.begin()) : -1;
+}
+
+// Per-worker results of one level
+struct alignas(64) LevelCounts {
+    std::vector<int> next;    // top-down: newly discovered nodes
+    size_t discovered = 0;
+    size_t edges = 0;         // out-edges of the discovered nodes
+};
+
+} // namespace
+
+int HopTree::hopsTo(int id) const {
+    int v = denseIndex(ids, id);
+    return v < 0 ? -1 : hops[v];
+}
+
+std::vector<int> HopTree::pathTo(int id) const {
+    std::vector<int> path;
+    if (hopsTo(id) < 0) {
+        return path;
+    }
+    for (int node = id; node != -1; node = parent[denseIndex(ids, node)]) {
+        path.push_back(node);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+// ParallelBFS
+
+ParallelBFS::ParallelBFS(size_t threads, double alpha, double beta)
+    : pool(threads), alpha(alpha), beta(beta) {}
+
+size_t ParallelBFS::solve(const CompactGraph& graph, int source, int goal,
+                          std::vector<int>& hops, std::vector<int>& parent,
+                          size_t& levels, size_t& bottomUpLevels) {
+    const size_t n = graph.nodeCount();
+    const size_t words = (n + 63) / 64;
+    auto outDegree = [&](int v) { return graph.edgeEnd(v) - graph.edgeBegin(v); };
+
+    std::unique_ptr<std::atomic<uint64_t>[]> visited(new std::atomic<uint64_t>[words]);
+    for (size_t w = 0; w < words; w++) {
+        visited[w].store(0, std::memory_order_relaxed);
+    }
+    std::vector<uint64_t> frontierBits(words, 0);
+    std::vector<uint64_t> nextBits(words, 0);
+    std::vector<LevelCounts> counts(pool.size());
+
+    hops.assign(n, -1);
+    parent.assign(n, -1);
+    levels = 0;
+    bottomUpLevels = 0;
+
+    std::vector<int> frontier{source};
+    visited[source >> 6].store(uint64_t(1) << (source & 63), std::memory_order_relaxed);
+    hops[source] = 0;
+
+    size_t frontierSize = 1;
+    size_t frontierEdges = outDegree(source);
+    size_t unexploredEdges = graph.edgeCount() - frontierEdges;
+    size_t visitedCount = 1;
+    bool bottomUp = false;
+
+    while (frontierSize > 0) {
+        if (goal >= 0 && hops[goal] >= 0) {
+            break;
+        }
+
+        // Direction switch heuristics, converting the frontier representation
+        if (!bottomUp && frontierEdges * alpha > unexploredEdges) {
+            bottomUp = true;
+            std::fill(frontierBits.begin(), frontierBits.end(), 0);
+            for (int v : frontier) {
+                frontierBits[v >> 6] |= uint64_t(1) << (v & 63);
+            }
+        } else if (bottomUp && frontierSize * beta < n) {
+            bottomUp = false;
+            frontier.clear();
+            for (size_t w = 0; w < words; w++) {
+                for (uint64_t bits = frontierBits[w]; bits != 0; bits &= bits - 1) {
+                    frontier.push_back(static_cast<int>(w * 64 + __builtin_ctzll(bits)));
+                }
+            }
+        }
+
+        const int nextLevel = static_cast<int>(levels) + 1;
+        for (auto& c : counts) {
+            c.discovered = 0;
+            c.edges = 0;
+        }
+
+        if (bottomUp) {
+            // Each worker owns whole words of the visited and next bitmaps
+            pool.parallelFor(words, [&](size_t w, size_t worker) {
+                uint64_t seen = visited[w].load(std::memory_order_relaxed);
+                uint64_t found = 0;
+                size_t end = std::min(n, (w + 1) * 64);
+                for (size_t v = w * 64; v < end; v++) {
+                    if (seen & (uint64_t(1) << (v & 63))) {
+                        continue;
+                    }
+                    int node = static_cast<int>(v);
+                    for (size_t e = graph.reverseBegin(node); e < graph.reverseEnd(node); e++) {
+                        int u = graph.reverseSource(e);
+                        if (frontierBits[u >> 6] & (uint64_t(1) << (u & 63))) {
+                            parent[node] = u;
+                            hops[node] = nextLevel;
+                            found |= uint64_t(1) << (v & 63);
+                            counts[worker].discovered++;
+                            counts[worker].edges += outDegree(node);
+                            break;
+                        }
+                    }
+                }
+                nextBits[w] = found;
+                if (found != 0) {
+                    visited[w].store(seen | found, std::memory_order_relaxed);
+                }
+            }, 64);
+            frontierBits.swap(nextBits);
+            bottomUpLevels++;
+        } else {
+            // Workers claim unvisited targets with an atomic fetch_or
+            pool.parallelFor(frontier.size(), [&](size_t i, size_t worker) {
+                int u = frontier[i];
+                for (size_t e = graph.edgeBegin(u); e < graph.edgeEnd(u); e++) {
+                    int v = graph.edgeTarget(e);
+                    uint64_t bit = uint64_t(1) << (v & 63);
+                    std::atomic<uint64_t>& word = visited[v >> 6];
+                    if ((word.load(std::memory_order_relaxed) & bit) ||
+                        (word.fetch_or(bit, std::memory_order_relaxed) & bit)) {
+                        continue;
+                    }
+                    parent[v] = u;
+                    hops[v] = nextLevel;
+                    counts[worker].next.push_back(v);
+                    counts[worker].discovered++;
+                    counts[worker].edges += outDegree(v);
+                }
+            }, 64);
+            frontier.clear();
+            for (auto& c : counts) {
+                frontier.insert(frontier.end(), c.next.begin(), c.next.end());
+                c.next.clear();
+            }
+        }
+
+        frontierSize = 0;
+        frontierEdges = 0;
+        for (const auto& c : counts) {
+            frontierSize += c.discovered;
+            frontierEdges += c.edges;
+        }
+        unexploredEdges -= std::min(unexploredEdges, frontierEdges);
+        visitedCount += frontierSize;
+        levels++;
+    }
+
+    return visitedCount;
+}
+
+HopTree ParallelBFS::run(const CompactGraph& graph, int sourceId) {
+    HopTree tree;
+    tree.sourceId = sourceId;
+    tree.ids.resize(graph.nodeCount());
+    for (size_t v = 0; v < graph.nodeCount(); v++) {
+        tree.ids[v] = graph.idOf(static_cast<int>(v));
+    }
+
+    int source = graph.indexOf(sourceId);
+    if (source < 0) {
+        tree.hops.assign(graph.nodeCount(), -1);
+        tree.parent.assign(graph.nodeCount(), -1);
+        return tree;
+    }
+
+    tree.reached = solve(graph, source, -1, tree.hops, tree.parent, tree.levels,
+                         tree.bottomUpLevels);
+    for (int& p : tree.parent) {
+        p = p < 0 ? -1 : graph.idOf(p);
+    }
+    return tree;
+}
+
+HopTree ParallelBFS::run(const Graph& graph, int sourceId) {
+    return run(graph.freeze(), sourceId);
+}
+
+PathResult ParallelBFS::search(const CompactGraph& graph, int startId, int goalId) {
+    int start = graph.indexOf(startId);
+    int goal = graph.indexOf(goalId);
+    if (start < 0 || goal < 0 || !graph.mayReach(start, goal)) {
+        return PathResult();
+    }
+
+    std::vector<int> hops;
+    std::vector<int> parent;
+    size_t levels = 0;
+    size_t bottomUpLevels = 0;
+    size_t nodesExplored = solve(graph, start, goal, hops, parent, levels, bottomUpLevels);
+    if (hops[goal] < 0) {
+        return PathResult();
+    }
+
+    // Cost of the found path, taking the first edge between consecutive nodes
+    std::vector<int> path;
+    double cost = 0.0;
+    for (int node = goal; node != -1; node = parent[node]) {
+        path.push_back(graph.idOf(node));
+        int from = parent[node];
+        if (from < 0) {
+            continue;
+        }
+        for (size_t e = graph.edgeBegin(from); e < graph.edgeEnd(from); e++) {
+            if (graph.edgeTarget(e) == node) {
+                cost += graph.edgeWeight(e);
+                break;
+            }
+        }
+    }
+    std::reverse(path.begin(), path.end());
+    return PathResult(path, cost, nodesExplored);
+}
+
+PathResult ParallelBFS::search(const Graph& graph, int startId, int goalId) {
+    if (!graph.mayReach(startId, goalId)) {
+        return PathResult();
+    }
+    return search(graph.freeze(), startId, goalId);
+}
+
+} // namespace sf
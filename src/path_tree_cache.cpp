@@ -0,0 +1,116 @@
+#include "sf/path_tree_cache.h"
+#include "compact_path.h"
+
+namespace sf {
+
+PathTreeCache::PathTreeCache(size_t memoryBudget) : budget(memoryBudget) {}
+
+PathResult PathTreeCache::search(const CompactGraph& graph, int startId, int goalId) {
+    int start = graph.indexOf(startId);
+    int goal = graph.indexOf(goalId);
+    if (start < 0 || goal < 0 || !graph.mayReach(start, goal)) {
+        return PathResult();
+    }
+
+    const Key key{start, graph.version()};
+    std::shared_ptr<Tree> tree;
+    bool missed = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = slots.find(key);
+        if (it != slots.end()) {
+            recency.splice(recency.begin(), recency, it->second.recent);
+            tree = it->second.tree;
+        } else {
+            tree = std::make_shared<Tree>();
+            recency.push_front(key);
+            slots[key] = Slot{tree, recency.begin(), 0};
+            counters.trees++;
+            missed = true;
+        }
+    }
+
+    PathResult result;
+    size_t bytes;
+    {
+        std::lock_guard<std::mutex> lock(tree->mutex);
+        SearchWorkspace& workspace = tree->workspace;
+        IndexedDaryHeap<4>& open = workspace.indexedHeap();
+        if (!tree->started) {
+            tree->started = true;
+            workspace.prepare(graph.nodeCount());
+            workspace.set(start, 0.0, -1);
+            open.push(start, 0.0);
+        }
+
+        // Resume Dijkstra exactly where the previous query on this tree stopped
+        while (!workspace.closed(goal) && !open.empty()) {
+            int current = open.pop();
+            workspace.close(current);
+            result.nodesExplored++;
+
+            double g = workspace.distance(current);
+            for (size_t e = graph.edgeBegin(current); e < graph.edgeEnd(current); e++) {
+                int next = graph.edgeTarget(e);
+                if (workspace.closed(next)) {
+                    continue;
+                }
+                double tentative = g + graph.edgeWeight(e);
+                if (tentative < workspace.distance(next)) {
+                    workspace.set(next, tentative, current);
+                    open.pushOrDecrease(next, tentative);
+                }
+            }
+        }
+        if (workspace.closed(goal)) {
+            result.found = true;
+            result.path = compact_internal::reconstructPath(graph, workspace, goal);
+            result.cost = workspace.distance(goal);
+        }
+        bytes = workspace.memoryUsage();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (missed) {
+        counters.misses++;
+    } else if (result.nodesExplored > 0) {
+        counters.resumed++;
+    } else {
+        counters.hits++;
+    }
+    auto it = slots.find(key);
+    if (it != slots.end() && it->second.tree == tree) {
+        counters.bytes = counters.bytes - it->second.bytes + bytes;
+        it->second.bytes = bytes;
+        evictOverBudget();
+    }
+    return result;
+}
+
+void PathTreeCache::evictOverBudget() {
+    // A tree in use elsewhere stays alive through its shared_ptr until that
+    // query returns
+    while (counters.bytes > budget && !recency.empty()) {
+        auto it = slots.find(recency.back());
+        counters.bytes -= it->second.bytes;
+        slots.erase(it);
+        recency.pop_back();
+        counters.trees--;
+        counters.evictions++;
+    }
+}
+
+void PathTreeCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    slots.clear();
+    recency.clear();
+    counters.trees = 0;
+    counters.bytes = 0;
+}
+
+PathTreeCacheStats PathTreeCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
+
+} // namespace sf
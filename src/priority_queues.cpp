@@ -0,0 +1,168 @@
+#include "sf/priority_queues.h"
+#include "sf/compact_graph.h"
+#include <stdexcept>
+
+namespace sf {
+
+namespace {
+
+// Scaled edge weights up to this bound use Dial buckets, larger ones the radix heap
+const double kBucketQueueMaxWeight = 4096.0;
+
+uint64_t integralKey(double key) {
+    return key <= 0.0 ? 0 : static_cast<uint64_t>(key);
+}
+
+} // namespace
+
+QueuePolicy resolveQueuePolicy(QueuePolicy requested, const CompactGraph& graph) {
+    double scale = graph.integerWeightScale();
+    if (requested == QueuePolicy::Auto) {
+        if (scale == 0.0) {
+            return QueuePolicy::DaryHeap;
+        }
+        return graph.maxEdgeWeight() * scale <= kBucketQueueMaxWeight
+            ? QueuePolicy::BucketQueue : QueuePolicy::RadixHeap;
+    }
+    if (requested != QueuePolicy::DaryHeap && scale == 0.0) {
+        throw std::runtime_error(
+            "Integer priority queue requires integral or fixed-point edge weights");
+    }
+    return requested;
+}
+
+// RadixHeap
+
+size_t RadixHeap::bucketIndex(uint64_t key, uint64_t last) {
+    // Bucket i > 0 holds keys whose highest bit differing from last is bit i-1
+    uint64_t diff = key ^ last;
+    return diff == 0 ? 0 : 64 - static_cast<size_t>(__builtin_clzll(diff));
+}
+
+void RadixHeap::push(const value_type& value) {
+    uint64_t key = integralKey(value.first);
+    if (key < last) {
+        key = last;
+    }
+    buckets[bucketIndex(key, last)].push_back(value);
+    count++;
+}
+
+void RadixHeap::refill() {
+    if (!buckets[0].empty()) {
+        return;
+    }
+
+    size_t i = 1;
+    while (buckets[i].empty()) {
+        i++;
+    }
+
+    uint64_t newLast = UINT64_MAX;
+    for (const auto& item : buckets[i]) {
+        uint64_t key = integralKey(item.first);
+        if (key < newLast) {
+            newLast = key;
+        }
+    }
+    if (newLast < last) {
+        newLast = last;
+    }
+    last = newLast;
+
+    // Every item of bucket i lands in a strictly lower bucket
+    std::vector<value_type> moving;
+    moving.swap(buckets[i]);
+    for (const auto& item : moving) {
+        uint64_t key = integralKey(item.first);
+        buckets[bucketIndex(key < last ? last : key, last)].push_back(item);
+    }
+    moving.clear();
+    moving.swap(buckets[i]);  // hand the capacity back to the bucket
+}
+
+const RadixHeap::value_type& RadixHeap::top() {
+    refill();
+    return buckets[0].back();
+}
+
+void RadixHeap::pop() {
+    refill();
+    buckets[0].pop_back();
+    count--;
+}
+
+void RadixHeap::clear() {
+    for (auto& bucket : buckets) {
+        bucket.clear();
+    }
+    last = 0;
+    count = 0;
+}
+
+// BucketQueue
+
+BucketQueue::BucketQueue(size_t keySpan) {
+    reserveSpan(keySpan);
+}
+
+void BucketQueue::reserveSpan(size_t keySpan) {
+    size_t size = buckets.empty() ? 1 : buckets.size();
+    while (size < keySpan + 1) {
+        size *= 2;
+    }
+    if (size == buckets.size()) {
+        return;
+    }
+
+    // Queued keys all lie in [cursor, cursor + old size), so they stay distinct
+    std::vector<std::vector<value_type>> grown(size);
+    for (auto& bucket : buckets) {
+        for (const auto& item : bucket) {
+            uint64_t key = integralKey(item.first);
+            grown[(key < cursor ? cursor : key) & (size - 1)].push_back(item);
+        }
+    }
+    buckets.swap(grown);
+}
+
+void BucketQueue::push(const value_type& value) {
+    uint64_t key = integralKey(value.first);
+    if (key < cursor) {
+        key = cursor;
+    }
+    if (key - cursor >= buckets.size()) {
+        reserveSpan(static_cast<size_t>(key - cursor));
+    }
+    buckets[key & (buckets.size() - 1)].push_back(value);
+    count++;
+}
+
+void BucketQueue::advance() {
+    while (buckets[cursor & (buckets.size() - 1)].empty()) {
+        cursor++;
+    }
+}
+
+const BucketQueue::value_type& BucketQueue::top() {
+    advance();
+    return buckets[cursor & (buckets.size() - 1)].back();
+}
+
+void BucketQueue::pop() {
+    advance();
+    buckets[cursor & (buckets.size() - 1)].pop_back();
+    count--;
+}
+
+void BucketQueue::clear() {
+    if (count > 0) {
+        for (auto& bucket : buckets) {
+            bucket.clear();
+        }
+    }
+    cursor = 0;
+    count = 0;
+}
+
+} // namespace sf
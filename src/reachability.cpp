@@ -0,0 +1,120 @@
+#include "sf/reachability.h"
+#include <algorithm>
+
+namespace sf {
+
+int ReachabilityIndex::addNode() {
+    int slot = static_cast<int>(parents.size());
+    parents.push_back(slot);
+    sizes.push_back(1);
+    // A new node is a component of its own and can go last in the order
+    ranks.push_back(nextRank++);
+    return slot;
+}
+
+int ReachabilityIndex::find(int slot) {
+    while (parents[slot] != slot) {
+        parents[slot] = parents[parents[slot]];
+        slot = parents[slot];
+    }
+    return slot;
+}
+
+void ReachabilityIndex::unite(int from, int to) {
+    int a = find(from);
+    int b = find(to);
+    if (a == b) {
+        return;
+    }
+    if (sizes[a] < sizes[b]) {
+        std::swap(a, b);
+    }
+    parents[b] = a;
+    sizes[a] += sizes[b];
+}
+
+void ReachabilityIndex::addEdge(int from, int to) {
+    unite(from, to);
+    if (strongCurrent && ranks[from] > ranks[to]) {
+        strongCurrent = false;
+    }
+}
+
+void ReachabilityIndex::clear() {
+    parents.clear();
+    sizes.clear();
+    ranks.clear();
+    nextRank = 0;
+    strongCurrent = false;
+}
+
+void ReachabilityIndex::build(const std::vector<size_t>& offsets,
+                              const std::vector<int>& targets) {
+    const int n = offsets.empty() ? 0 : static_cast<int>(offsets.size()) - 1;
+    clear();
+    for (int v = 0; v < n; v++) {
+        addNode();
+    }
+    for (int v = 0; v < n; v++) {
+        for (size_t e = offsets[v]; e < offsets[v + 1]; e++) {
+            unite(v, targets[e]);
+        }
+    }
+    // Flatten so weakComponent() is a single lookup
+    for (int v = 0; v < n; v++) {
+        parents[v] = find(v);
+    }
+
+    // Tarjan with an explicit stack of (node, next edge) frames. Components
+    // are emitted in reverse topological order, so ranks count down.
+    std::vector<int> lowlink(n), order(n, -1);
+    std::vector<char> onStack(n, 0);
+    std::vector<int> members;
+    std::vector<std::pair<int, size_t>> frames;
+    int visited = 0;
+    int rank = n;
+    for (int root = 0; root < n; root++) {
+        if (order[root] >= 0) {
+            continue;
+        }
+        frames.emplace_back(root, offsets[root]);
+        order[root] = lowlink[root] = visited++;
+        members.push_back(root);
+        onStack[root] = 1;
+        while (!frames.empty()) {
+            auto& [v, e] = frames.back();
+            if (e < offsets[v + 1]) {
+                int w = targets[e++];
+                if (order[w] < 0) {
+                    order[w] = lowlink[w] = visited++;
+                    members.push_back(w);
+                    onStack[w] = 1;
+                    frames.emplace_back(w, offsets[w]);
+                } else if (onStack[w]) {
+                    lowlink[v] = std::min(lowlink[v], order[w]);
+                }
+                continue;
+            }
+            int done = v;
+            frames.pop_back();
+            if (!frames.empty()) {
+                int parent = frames.back().first;
+                lowlink[parent] = std::min(lowlink[parent], lowlink[done]);
+            }
+            if (lowlink[done] == order[done]) {
+                rank--;
+                int w;
+                do {
+                    w = members.back();
+                    members.pop_back();
+                    onStack[w] = 0;
+                    ranks[w] = rank;
+                } while (w != done);
+            }
+        }
+    }
+    nextRank = n;
+    strongCurrent = true;
+}
+
+} // namespace sf
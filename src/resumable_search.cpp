@@ -0,0 +1,152 @@
+#include "sf/resumable_search.h"
+#include "sf/search_engine.h"
+#include <stdexcept>
+#include <type_traits>
+
+namespace sf {
+
+struct ResumableSearch::State {
+    virtual ~State() = default;
+    virtual SearchStatus advance(size_t maxExpansions) = 0;
+    virtual SearchStatus status() const = 0;
+    virtual size_t expanded() const = 0;
+    virtual PathResult result() const = 0;
+};
+
+namespace {
+
+using Items = std::vector<std::pair<double, int>>;
+
+// Heuristic functor that owns its std::function; engine::FunctionHeuristic
+// only refers to one, which would not outlive the constructor
+struct OwnedHeuristic {
+    Heuristic heuristic;
+    double operator()(const Node& a, const Node& b) const { return heuristic(a, b); }
+};
+
+template <typename F>
+auto withOwnedHeuristic(const Heuristic& heuristic, F&& f) {
+    return engine::withHeuristic(heuristic, [&](const auto& h) {
+        using H = std::decay_t<decltype(h)>;
+        if constexpr (std::is_same_v<H, engine::FunctionHeuristic>) {
+            return f(OwnedHeuristic{heuristic});
+        } else {
+            return f(h);
+        }
+    });
+}
+
+// Engine cursor together with everything it refers to
+template <typename Queue, typename Visited, typename H, typename Order>
+class Slice final : public ResumableSearch::State {
+public:
+    template <typename MakeQueue>
+    Slice(const CompactGraph& graph, MakeQueue makeQueue, Visited visitedPolicy, H h,
+          int startId, int goalId)
+        : view(graph), queue(makeQueue(items)), visited(std::move(visitedPolicy)),
+          heuristic(std::move(h)), cursor(view, queue, visited, heuristic, startId, goalId) {}
+
+    SearchStatus advance(size_t maxExpansions) override { return cursor.advance(maxExpansions); }
+    SearchStatus status() const override { return cursor.status(); }
+    size_t expanded() const override { return cursor.expanded(); }
+    PathResult result() const override { return cursor.result(); }
+
+private:
+    engine::CompactGraphView view;
+    Items items;   // FIFO / LIFO storage when there is no workspace
+    Queue queue;
+    Visited visited;
+    H heuristic;
+    typename engine::BestFirstEngine<engine::CompactGraphView, Queue, Visited, H, Order>::Cursor
+        cursor;
+};
+
+// makeHeap(items) builds the priority queue, list(items) the FIFO / LIFO storage
+template <typename Visited, typename MakeHeap, typename List>
+std::unique_ptr<ResumableSearch::State> create(const CompactGraph& graph, int startId,
+                                               int goalId, PlanAlgorithm algorithm,
+                                               const Heuristic& heuristic, Visited visited,
+                                               MakeHeap makeHeap, List list) {
+    using State = ResumableSearch::State;
+    using HeapQueue = decltype(makeHeap(std::declval<Items&>()));
+    auto makeFifo = [&](Items& items) { return engine::FifoQueue(list(items)); };
+    auto makeLifo = [&](Items& items) { return engine::LifoQueue(list(items)); };
+
+    switch (algorithm) {
+    case PlanAlgorithm::BFS:
+        return std::make_unique<
+            Slice<engine::FifoQueue, Visited, engine::ZeroHeuristic, engine::CostOrder>>(
+            graph, makeFifo, std::move(visited), engine::ZeroHeuristic(), startId, goalId);
+    case PlanAlgorithm::DFS:
+        return std::make_unique<
+            Slice<engine::LifoQueue, Visited, engine::ZeroHeuristic, engine::CostOrder>>(
+            graph, makeLifo, std::move(visited), engine::ZeroHeuristic(), startId, goalId);
+    case PlanAlgorithm::Dijkstra:
+        return std::make_unique<
+            Slice<HeapQueue, Visited, engine::ZeroHeuristic, engine::CostOrder>>(
+            graph, makeHeap, std::move(visited), engine::ZeroHeuristic(), startId, goalId);
+    case PlanAlgorithm::BestFirst:
+        return withOwnedHeuristic(heuristic, [&](auto h) -> std::unique_ptr<State> {
+            return std::make_unique<Slice<HeapQueue, Visited, decltype(h), engine::GreedyOrder>>(
+                graph, makeHeap, std::move(visited), std::move(h), startId, goalId);
+        });
+    case PlanAlgorithm::AStar:
+        return withOwnedHeuristic(heuristic, [&](auto h) -> std::unique_ptr<State> {
+            return std::make_unique<Slice<HeapQueue, Visited, decltype(h), engine::CostOrder>>(
+                graph, makeHeap, std::move(visited), std::move(h), startId, goalId);
+        });
+    default:
+        throw std::runtime_error("ResumableSearch: bidirectional searches cannot run in slices");
+    }
+}
+
+} // namespace
+
+ResumableSearch::ResumableSearch(const CompactGraph& graph, int startId, int goalId,
+                                 PlanAlgorithm algorithm, Heuristic heuristic)
+    : state(create(graph, startId, goalId, algorithm, heuristic, engine::HashVisited(),
+                   [](Items&) { return engine::LazyHeapQueue(); },
+                   [](Items& items) -> Items& { return items; })) {}
+
+ResumableSearch::ResumableSearch(const CompactGraph& graph, int startId, int goalId,
+                                 PlanAlgorithm algorithm, Heuristic heuristic,
+                                 SearchWorkspace& workspace)
+    : state(create(graph, startId, goalId, algorithm, heuristic,
+                   engine::DenseVisited(workspace),
+                   [&](Items&) { return engine::IndexedHeapQueue(workspace.indexedHeap()); },
+                   [&](Items&) -> Items& { return workspace.list(); })) {}
+
+ResumableSearch::~ResumableSearch() = default;
+ResumableSearch::ResumableSearch(ResumableSearch&&) noexcept = default;
+ResumableSearch& ResumableSearch::operator=(ResumableSearch&&) noexcept = default;
+
+SearchStatus ResumableSearch::step(size_t maxExpansions) {
+    return state->advance(maxExpansions);
+}
+
+SearchStatus ResumableSearch::stepFor(Clock::duration budget) {
+    const Clock::time_point deadline = Clock::now() + budget;
+    SearchStatus status = state->advance(256);
+    while (status == SearchStatus::Running && Clock::now() < deadline) {
+        status = state->advance(256);
+    }
+    return status;
+}
+
+SearchStatus ResumableSearch::finish() {
+    return state->advance(std::numeric_limits<size_t>::max());
+}
+
+SearchStatus ResumableSearch::status() const {
+    return state->status();
+}
+
+size_t ResumableSearch::nodesExplored() const {
+    return state->expanded();
+}
+
+PathResult ResumableSearch::result() const {
+    return state->result();
+}
+
+} // namespace sf
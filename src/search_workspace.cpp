@@ -0,0 +1,32 @@
+#include "sf/search_workspace.h"
+#include <algorithm>
+
+namespace sf {
+
+void SearchWorkspace::prepare(size_t nodeCount) {
+    if (entries.size() < nodeCount) {
+        entries.resize(nodeCount, Entry{std::numeric_limits<double>::infinity(), -1, 0, 0});
+    }
+    openList.clear();
+    openHeap.clear();
+    openHeap.resize(nodeCount);
+    radix.clear();
+    buckets.clear();
+    
+    generation++;
+    if (generation == 0) {
+        // Stamps wrapped around: forget every entry explicitly once
+        for (auto& e : entries) {
+            e.stamp = 0;
+            e.closedStamp = 0;
+        }
+        generation = 1;
+    }
+}
+
+SearchWorkspace& SearchWorkspace::local(size_t slot) {
+    thread_local SearchWorkspace workspaces[2];
+    return workspaces[slot];
+}
+
+} // namespace sf
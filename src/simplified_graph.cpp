@@ -0,0 +1,326 @@
+#include "sf/simplified_graph.h"
+#include "sf/search_engine.h"
+#include "compact_path.h"
+#include <algorithm>
+#include <limits>
+
+namespace sf {
+
+namespace {
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+// Cheapest from -> to edge, infinity if there is none or to is blocked
+double cheapestEdge(const Graph& graph, int from, int to) {
+    double best = kInfinity;
+    for (const auto& edge : graph.getNeighbors(from)) {
+        if (edge.to == to && !graph.isBlocked(to)) {
+            best = std::min(best, edge.weight);
+        }
+    }
+    return best;
+}
+
+// A chain end a path may start or stop at, with the cost of walking the
+// chain between it and the contracted endpoint
+struct Attachment {
+    int node;       // dense index in the reduced graph
+    size_t index;   // position of the end in its chain
+    double cost;
+};
+
+} // namespace
+
+double SimplifiedGraph::Chain::cost(size_t from, size_t to) const {
+    double total = 0.0;
+    for (size_t i = from; i < to; i++) {
+        total += forward[i];
+    }
+    for (size_t i = to; i < from; i++) {
+        total += backward[i];
+    }
+    return total;
+}
+
+void SimplifiedGraph::Chain::appendBetween(size_t from, size_t to, std::vector<int>& out) const {
+    if (from < to) {
+        for (size_t i = from + 1; i < to; i++) {
+            out.push_back(nodes[i]);
+        }
+    } else {
+        for (size_t i = from; i > to + 1; i--) {
+            out.push_back(nodes[i - 1]);
+        }
+    }
+}
+
+SimplifiedGraph::SimplifiedGraph(const Graph& graph) {
+    std::vector<int> ids = graph.getNodeIds();
+    std::sort(ids.begin(), ids.end());
+
+    // Distinct neighbours over incoming and outgoing edges; edges into
+    // blocked nodes are not traversable
+    std::unordered_map<int, std::vector<int>> neighbours;
+    std::unordered_map<int, bool> chainNode;
+    for (int id : ids) {
+        neighbours[id];
+        chainNode[id] = true;
+    }
+    for (int id : ids) {
+        for (const auto& edge : graph.getNeighbors(id)) {
+            if (graph.isBlocked(edge.to)) {
+                continue;
+            }
+            if (edge.to == id) {
+                chainNode[id] = false;
+            }
+            neighbours[id].push_back(edge.to);
+            neighbours[edge.to].push_back(id);
+        }
+    }
+    for (int id : ids) {
+        auto& list = neighbours[id];
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        chainNode[id] = chainNode[id] && list.size() == 2;
+    }
+
+    // Walk from a chain node through prev until the first kept node; returns
+    // the nodes after from, ending with the kept one, or an empty list if the
+    // walk came back to from (a ring of chain nodes)
+    auto walk = [&](int from, int first) {
+        std::vector<int> run;
+        int prev = from;
+        int current = first;
+        while (true) {
+            if (current == from) {
+                return std::vector<int>();
+            }
+            run.push_back(current);
+            if (!chainNode[current]) {
+                return run;
+            }
+            const auto& list = neighbours[current];
+            int next = list[0] == prev ? list[1] : list[0];
+            prev = current;
+            current = next;
+        }
+    };
+
+    for (int id : ids) {
+        if (!chainNode[id] || positions.count(id) > 0) {
+            continue;
+        }
+        std::vector<int> left = walk(id, neighbours[id][0]);
+        if (left.empty()) {
+            // Keep one node of the ring; the rest becomes a loop through it
+            chainNode[id] = false;
+            continue;
+        }
+        std::vector<int> right = walk(id, neighbours[id][1]);
+
+        Chain chain;
+        chain.nodes.assign(left.rbegin(), left.rend());
+        chain.nodes.push_back(id);
+        chain.nodes.insert(chain.nodes.end(), right.begin(), right.end());
+        for (size_t i = 0; i + 1 < chain.nodes.size(); i++) {
+            chain.forward.push_back(cheapestEdge(graph, chain.nodes[i], chain.nodes[i + 1]));
+            chain.backward.push_back(cheapestEdge(graph, chain.nodes[i + 1], chain.nodes[i]));
+        }
+        const int c = static_cast<int>(chains.size());
+        for (size_t i = 1; i + 1 < chain.nodes.size(); i++) {
+            positions[chain.nodes[i]] = Position{c, i, graph.getNode(chain.nodes[i])};
+        }
+        chains.push_back(std::move(chain));
+    }
+
+    for (int id : ids) {
+        if (!chainNode[id]) {
+            reduced.addNode(graph.getNode(id));
+        }
+    }
+    for (int id : ids) {
+        if (chainNode[id]) {
+            continue;
+        }
+        for (const auto& edge : graph.getNeighbors(id)) {
+            if (!chainNode[edge.to] && !graph.isBlocked(edge.to)) {
+                reduced.addEdge(id, edge.to, edge.weight);
+            }
+        }
+    }
+
+    // Shortcuts, each only if it beats every edge already between its ends
+    for (size_t c = 0; c < chains.size(); c++) {
+        const Chain& chain = chains[c];
+        const size_t last = chain.nodes.size() - 1;
+        const int a = chain.nodes.front();
+        const int b = chain.nodes.back();
+        if (a == b) {
+            continue;
+        }
+        for (bool forward : {true, false}) {
+            int from = forward ? a : b;
+            int to = forward ? b : a;
+            double weight = forward ? chain.cost(0, last) : chain.cost(last, 0);
+            if (weight < cheapestEdge(reduced, from, to)) {
+                reduced.addEdge(from, to, weight);
+                shortcuts[pairKey(from, to)] = Shortcut{static_cast<int>(c), forward};
+            }
+        }
+    }
+
+    frozen = reduced.freeze();
+}
+
+std::vector<int> SimplifiedGraph::expandPath(const std::vector<int>& path) const {
+    std::vector<int> expanded;
+    for (size_t i = 0; i < path.size(); i++) {
+        if (i > 0) {
+            auto it = shortcuts.find(pairKey(path[i - 1], path[i]));
+            if (it != shortcuts.end()) {
+                const Chain& chain = chains[it->second.chain];
+                const size_t last = chain.nodes.size() - 1;
+                if (it->second.forward) {
+                    chain.appendBetween(0, last, expanded);
+                } else {
+                    chain.appendBetween(last, 0, expanded);
+                }
+            }
+        }
+        expanded.push_back(path[i]);
+    }
+    return expanded;
+}
+
+PathResult SimplifiedGraph::expand(const PathResult& result) const {
+    PathResult expanded = result;
+    expanded.path = expandPath(result.path);
+    return expanded;
+}
+
+PathResult SimplifiedGraph::search(int startId, int goalId, Heuristic heuristic) const {
+    return search(startId, goalId, heuristic, SearchWorkspace::local());
+}
+
+PathResult SimplifiedGraph::search(int startId, int goalId, Heuristic heuristic,
+                                   SearchWorkspace& workspace) const {
+    auto startPosition = positions.find(startId);
+    auto goalPosition = positions.find(goalId);
+    const bool startContracted = startPosition != positions.end();
+    const bool goalContracted = goalPosition != positions.end();
+    if ((!startContracted && !reduced.hasNode(startId)) ||
+        (!goalContracted && !reduced.hasNode(goalId))) {
+        return PathResult();
+    }
+    if (startId == goalId) {
+        return PathResult({startId}, 0.0, 1);
+    }
+
+    // Where the search may leave the start and reach the goal
+    std::vector<Attachment> sources;
+    std::vector<Attachment> targets;
+    double best = kInfinity;
+    if (startContracted) {
+        const Position& p = startPosition->second;
+        const Chain& chain = chains[p.chain];
+        for (size_t end : {size_t(0), chain.nodes.size() - 1}) {
+            sources.push_back({frozen.indexOf(chain.nodes[end]), end, chain.cost(p.index, end)});
+        }
+        if (goalContracted && goalPosition->second.chain == p.chain) {
+            best = chain.cost(p.index, goalPosition->second.index);
+        }
+    } else {
+        sources.push_back({frozen.indexOf(startId), 0, 0.0});
+    }
+    if (goalContracted) {
+        const Position& q = goalPosition->second;
+        const Chain& chain = chains[q.chain];
+        for (size_t end : {size_t(0), chain.nodes.size() - 1}) {
+            targets.push_back({frozen.indexOf(chain.nodes[end]), end, chain.cost(end, q.index)});
+        }
+    } else {
+        targets.push_back({frozen.indexOf(goalId), 0, 0.0});
+    }
+    const Node goalNode = goalContracted ? goalPosition->second.node : reduced.getNode(goalId);
+
+    // A* from every source end; the goal is reached through a target end
+    // once no open node can lead to a cheaper total
+    const Attachment* bestTarget = nullptr;
+    size_t nodesExplored = 0;
+    engine::withHeuristic(heuristic, [&](const auto& base) {
+        auto h = [&](int v) { return base(frozen.node(v), goalNode); };
+        workspace.prepare(frozen.nodeCount());
+        IndexedDaryHeap<4>& open = workspace.indexedHeap();
+        for (const Attachment& source : sources) {
+            if (source.cost < workspace.distance(source.node)) {
+                workspace.set(source.node, source.cost, -1);
+                open.pushOrDecrease(source.node, source.cost + h(source.node));
+            }
+        }
+        while (!open.empty() && open.topKey() < best) {
+            int current = open.pop();
+            workspace.close(current);
+            nodesExplored++;
+
+            double g = workspace.distance(current);
+            for (const Attachment& target : targets) {
+                if (target.node == current && g + target.cost < best) {
+                    best = g + target.cost;
+                    bestTarget = &target;
+                }
+            }
+            for (size_t e = frozen.edgeBegin(current); e < frozen.edgeEnd(current); e++) {
+                int next = frozen.edgeTarget(e);
+                if (workspace.closed(next)) {
+                    continue;
+                }
+                double tentative = g + frozen.edgeWeight(e);
+                if (tentative < workspace.distance(next)) {
+                    workspace.set(next, tentative, current);
+                    open.pushOrDecrease(next, tentative + h(next));
+                }
+            }
+        }
+    });
+    if (best == kInfinity) {
+        PathResult none;
+        none.nodesExplored = nodesExplored;
+        return none;
+    }
+
+    std::vector<int> path = {startId};
+    if (bestTarget == nullptr) {
+        // Straight along the chain both endpoints lie on
+        chains[startPosition->second.chain].appendBetween(startPosition->second.index,
+                                                          goalPosition->second.index, path);
+        path.push_back(goalId);
+        return PathResult(path, best, nodesExplored);
+    }
+
+    std::vector<int> middle = expandPath(
+        compact_internal::reconstructPath(frozen, workspace, bestTarget->node));
+    if (startContracted) {
+        // The source end the search kept is the one with the cheaper walk
+        const Position& p = startPosition->second;
+        const Attachment* from = nullptr;
+        for (const Attachment& source : sources) {
+            if (frozen.idOf(source.node) == middle.front() &&
+                (from == nullptr || source.cost < from->cost)) {
+                from = &source;
+            }
+        }
+        chains[p.chain].appendBetween(p.index, from->index, path);
+        path.insert(path.end(), middle.begin(), middle.end());
+    } else {
+        path = middle;
+    }
+    if (goalContracted) {
+        chains[goalPosition->second.chain].appendBetween(bestTarget->index,
+                                                         goalPosition->second.index, path);
+        path.push_back(goalId);
+    }
+    return PathResult(path, best, nodesExplored);
+}
+
+} // namespace sf
@@ -0,0 +1,161 @@
+#include "sf/thread_pool.h"
+
+namespace sf {
+
+size_t ThreadPool::defaultThreadCount() {
+    size_t n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) {
+        threads = defaultThreadCount();
+    }
+    blocks.reset(new Block[threads]);
+    workers.reserve(threads - 1);
+    for (size_t w = 1; w < threads; w++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, w);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Pop up to grain indices from the front of the worker's own block
+bool ThreadPool::takeChunk(size_t worker, size_t& begin, size_t& end) {
+    Block& own = blocks[worker];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (own.begin >= own.end) {
+        return false;
+    }
+    begin = own.begin;
+    end = own.end - own.begin > jobGrain ? own.begin + jobGrain : own.end;
+    own.begin = end;
+    return true;
+}
+
+// Move the back half of the first non-empty victim block into the worker's
+// own (empty) block
+bool ThreadPool::steal(size_t worker) {
+    const size_t n = size();
+    for (size_t offset = 1; offset < n; offset++) {
+        Block& victim = blocks[(worker + offset) % n];
+        size_t begin;
+        size_t end;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.begin >= victim.end) {
+                continue;
+            }
+            end = victim.end;
+            begin = victim.begin + (victim.end - victim.begin) / 2;
+            victim.end = begin;
+        }
+        Block& own = blocks[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.begin = begin;
+        own.end = end;
+        return true;
+    }
+    return false;
+}
+
+// Drop all remaining indices so every worker drains quickly
+void ThreadPool::cancel() {
+    for (size_t w = 0; w < size(); w++) {
+        std::lock_guard<std::mutex> lock(blocks[w].mutex);
+        blocks[w].begin = blocks[w].end;
+    }
+}
+
+void ThreadPool::runChunks(size_t worker) {
+    size_t begin;
+    size_t end;
+    while (takeChunk(worker, begin, end) || (steal(worker) && takeChunk(worker, begin, end))) {
+        try {
+            for (size_t i = begin; i < end; i++) {
+                (*job)(i, worker);
+            }
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+            cancel();
+            return;
+        }
+    }
+}
+
+void ThreadPool::workerLoop(size_t worker) {
+    size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+
+        runChunks(worker);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busy == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t, size_t)>& fn,
+                             size_t grain) {
+    if (count == 0) {
+        return;
+    }
+    if (workers.empty() || count <= grain) {
+        for (size_t i = 0; i < count; i++) {
+            fn(i, 0);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        jobGrain = grain == 0 ? 1 : grain;
+        const size_t n = size();
+        for (size_t w = 0; w < n; w++) {
+            std::lock_guard<std::mutex> blockLock(blocks[w].mutex);
+            blocks[w].begin = count * w / n;
+            blocks[w].end = count * (w + 1) / n;
+        }
+        error = nullptr;
+        busy = workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    runChunks(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return busy == 0; });
+    job = nullptr;
+    if (error) {
+        std::exception_ptr e = error;
+        error = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+} // namespace sf
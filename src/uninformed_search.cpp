@@ -1,192 +1,109 @@
 #include "sf/uninformed_search.h"
-#include <unordered_set>
-#include <unordered_map>
-#include <queue>
-#include <stack>
+#include "sf/search_engine.h"
+#include "bidirectional_search.h"
 
 namespace sf {
 
 // 1.1 Breadth-First Search (BFS)
 PathResult BFS::search(const Graph& graph, int startId, int goalId) {
-    if (!graph.hasNode(startId) || !graph.hasNode(goalId)) {
-        return PathResult();
-    }
-    
-    std::unordered_set<int> visited;
-    std::unordered_map<int, int> parent;
-    std::queue<int> queue;
-    
-    queue.push(startId);
-    visited.insert(startId);
-    parent[startId] = -1;
-    
-    size_t nodesExplored = 0;
-    
-    while (!queue.empty()) {
-        int current = queue.front();
-        queue.pop();
-        nodesExplored++;
-        
-        if (current == goalId) {
-            // Reconstruct path
-            std::vector<int> path;
-            int node = goalId;
-            while (node != -1) {
-                path.push_back(node);
-                node = parent[node];
-            }
-            std::reverse(path.begin(), path.end());
-            
-            // Calculate cost
-            double cost = 0.0;
-            for (size_t i = 1; i < path.size(); i++) {
-                const auto& neighbors = graph.getNeighbors(path[i-1]);
-                for (const auto& edge : neighbors) {
-                    if (edge.to == path[i]) {
-                        cost += edge.weight;
-                        break;
-                    }
-                }
-            }
-            
-            return PathResult(path, cost, nodesExplored);
-        }
-        
-        const auto& neighbors = graph.getNeighbors(current);
-        for (const auto& edge : neighbors) {
-            if (visited.find(edge.to) == visited.end()) {
-                visited.insert(edge.to);
-                parent[edge.to] = current;
-                queue.push(edge.to);
-            }
-        }
-    }
-    
-    return PathResult();
+    std::vector<std::pair<double, int>> items;
+    engine::FifoQueue queue(items);
+    engine::HashVisited visited;
+    return engine::run(engine::GraphView(graph), queue, visited, engine::ZeroHeuristic(),
+                       startId, goalId);
+}
+
+PathResult BFS::search(const CompactGraph& graph, int startId, int goalId) {
+    return search(graph, startId, goalId, SearchWorkspace::local());
+}
+
+PathResult BFS::search(const CompactGraph& graph, int startId, int goalId,
+                       SearchWorkspace& workspace) {
+    engine::FifoQueue queue(workspace.list());
+    engine::DenseVisited visited(workspace);
+    return engine::run(engine::CompactGraphView(graph), queue, visited, engine::ZeroHeuristic(),
+                       startId, goalId);
 }
 
 // 1.2 Depth-First Search (DFS)
 PathResult DFS::search(const Graph& graph, int startId, int goalId) {
-    if (!graph.hasNode(startId) || !graph.hasNode(goalId)) {
-        return PathResult();
-    }
-    
-    std::unordered_set<int> visited;
-    std::unordered_map<int, int> parent;
-    std::stack<int> stack;
-    
-    stack.push(startId);
-    visited.insert(startId);
-    parent[startId] = -1;
-    
-    size_t nodesExplored = 0;
-    
-    while (!stack.empty()) {
-        int current = stack.top();
-        stack.pop();
-        nodesExplored++;
-        
-        if (current == goalId) {
-            // Reconstruct path
-            std::vector<int> path;
-            int node = goalId;
-            while (node != -1) {
-                path.push_back(node);
-                node = parent[node];
-            }
-            std::reverse(path.begin(), path.end());
-            
-            // Calculate cost
-            double cost = 0.0;
-            for (size_t i = 1; i < path.size(); i++) {
-                const auto& neighbors = graph.getNeighbors(path[i-1]);
-                for (const auto& edge : neighbors) {
-                    if (edge.to == path[i]) {
-                        cost += edge.weight;
-                        break;
-                    }
-                }
-            }
-            
-            return PathResult(path, cost, nodesExplored);
-        }
-        
-        const auto& neighbors = graph.getNeighbors(current);
-        for (const auto& edge : neighbors) {
-            if (visited.find(edge.to) == visited.end()) {
-                visited.insert(edge.to);
-                parent[edge.to] = current;
-                stack.push(edge.to);
-            }
-        }
-    }
-    
-    return PathResult();
+    std::vector<std::pair<double, int>> items;
+    engine::LifoQueue stack(items);
+    engine::HashVisited visited;
+    return engine::run(engine::GraphView(graph), stack, visited, engine::ZeroHeuristic(),
+                       startId, goalId);
+}
+
+PathResult DFS::search(const CompactGraph& graph, int startId, int goalId) {
+    return search(graph, startId, goalId, SearchWorkspace::local());
+}
+
+PathResult DFS::search(const CompactGraph& graph, int startId, int goalId,
+                       SearchWorkspace& workspace) {
+    engine::LifoQueue stack(workspace.list());
+    engine::DenseVisited visited(workspace);
+    return engine::run(engine::CompactGraphView(graph), stack, visited, engine::ZeroHeuristic(),
+                       startId, goalId);
 }
 
 // 1.3 Dijkstra's Algorithm
 PathResult Dijkstra::search(const Graph& graph, int startId, int goalId) {
-    if (!graph.hasNode(startId) || !graph.hasNode(goalId)) {
-        return PathResult();
+    engine::LazyHeapQueue pq;
+    engine::HashVisited visited;
+    return engine::run(engine::GraphView(graph), pq, visited, engine::ZeroHeuristic(),
+                       startId, goalId);
+}
+
+PathResult Dijkstra::search(const CompactGraph& graph, int startId, int goalId) {
+    return search(graph, startId, goalId, SearchWorkspace::local());
+}
+
+PathResult Dijkstra::search(const CompactGraph& graph, int startId, int goalId,
+                            SearchWorkspace& workspace, QueuePolicy queue) {
+    engine::CompactGraphView view(graph);
+    engine::DenseVisited visited(workspace);
+    const double scale = graph.integerWeightScale();
+    
+    switch (resolveQueuePolicy(queue, graph)) {
+    case QueuePolicy::RadixHeap: {
+        engine::IntegerQueue<RadixHeap> pq(workspace.radixHeap(), scale);
+        return engine::run(view, pq, visited, engine::ZeroHeuristic(), startId, goalId);
     }
-    
-    std::unordered_map<int, double> dist;
-    std::unordered_map<int, int> parent;
-    std::unordered_set<int> visited;
-    
-    // Priority queue: (distance, node)
-    using Pair = std::pair<double, int>;
-    auto cmp = [](const Pair& a, const Pair& b) { return a.first > b.first; };
-    std::priority_queue<Pair, std::vector<Pair>, decltype(cmp)> pq(cmp);
-    
-    // Initialize
-    for (const auto& pair : graph.getNodes()) {
-        dist[pair.first] = std::numeric_limits<double>::infinity();
+    case QueuePolicy::BucketQueue: {
+        workspace.bucketQueue().reserveSpan(static_cast<size_t>(graph.maxEdgeWeight() * scale));
+        engine::IntegerQueue<BucketQueue> pq(workspace.bucketQueue(), scale);
+        return engine::run(view, pq, visited, engine::ZeroHeuristic(), startId, goalId);
     }
-    dist[startId] = 0.0;
-    parent[startId] = -1;
-    pq.push({0.0, startId});
-    
-    size_t nodesExplored = 0;
-    
-    while (!pq.empty()) {
-        auto [d, current] = pq.top();
-        pq.pop();
-        
-        if (visited.find(current) != visited.end()) {
-            continue;
-        }
-        visited.insert(current);
-        nodesExplored++;
-        
-        if (current == goalId) {
-            // Reconstruct path
-            std::vector<int> path;
-            int node = goalId;
-            while (node != -1) {
-                path.push_back(node);
-                node = parent[node];
-            }
-            std::reverse(path.begin(), path.end());
-            return PathResult(path, dist[goalId], nodesExplored);
-        }
-        
-        const auto& neighbors = graph.getNeighbors(current);
-        for (const auto& edge : neighbors) {
-            if (visited.find(edge.to) != visited.end()) {
-                continue;
-            }
-            
-            double newDist = dist[current] + edge.weight;
-            if (newDist < dist[edge.to]) {
-                dist[edge.to] = newDist;
-                parent[edge.to] = current;
-                pq.push({newDist, edge.to});
-            }
-        }
+    default: {
+        // Indexed heap: each node is queued at most once and relaxations decrease its key
+        engine::IndexedHeapQueue pq(workspace.indexedHeap());
+        return engine::run(view, pq, visited, engine::ZeroHeuristic(), startId, goalId);
+    }
+    }
+}
+
+// 1.4 Bidirectional Dijkstra
+PathResult BidirectionalDijkstra::search(const Graph& graph, int startId, int goalId) {
+    if (!graph.mayReach(startId, goalId)) {
+        return PathResult();
+    }
+    return search(graph.freeze(), startId, goalId);
+}
+
+PathResult BidirectionalDijkstra::search(const CompactGraph& graph, int startId, int goalId) {
+    return search(graph, startId, goalId, SearchWorkspace::local(0), SearchWorkspace::local(1));
+}
+
+PathResult BidirectionalDijkstra::search(const CompactGraph& graph, int startId, int goalId,
+                                         SearchWorkspace& forward, SearchWorkspace& backward) {
+    int start = graph.indexOf(startId);
+    int goal = graph.indexOf(goalId);
+    if (start < 0 || goal < 0 || !graph.mayReach(start, goal)) {
+        return PathResult();
     }
     
-    return PathResult();
+    return bidirectional_internal::search(graph, start, goal, forward, backward,
+                                          [](int) { return 0.0; });
 }
 
 } // namespace sf
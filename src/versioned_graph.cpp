@@ -0,0 +1,253 @@
+#include "sf/versioned_graph.h"
+#include "sf/compact_graph.h"
+#include "sf/search_engine.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace sf {
+
+namespace {
+
+// Engine view over one pinned version
+class SnapshotView {
+public:
+    explicit SnapshotView(const GraphSnapshot& graph) : graph(graph) {}
+
+    size_t nodeCount() const { return graph.nodeCount(); }
+    bool contains(int id) const { return graph.hasNode(id); }
+    int handle(int id) const { return graph.indexOf(id); }
+    int id(int node) const { return graph.idOf(node); }
+    bool mayReach(int from, int to) const { return graph.mayReach(from, to); }
+    Node node(int node) const { return graph.node(node); }
+
+    template <typename F>
+    void forEachEdge(int node, F&& f) const {
+        graph.forEachEdge(node, f);
+    }
+
+    // Weight of the first from -> to edge
+    double edgeCost(int from, int to) const {
+        double cost = 0.0;
+        bool found = false;
+        graph.forEachEdge(from, [&](int target, double weight) {
+            if (!found && target == to) {
+                cost = weight;
+                found = true;
+            }
+        });
+        return cost;
+    }
+
+private:
+    const GraphSnapshot& graph;
+};
+
+} // namespace
+
+int GraphSnapshot::indexOf(int id) const {
+    const auto& index = state->nodes->index;
+    auto it = index.find(id);
+    return it == index.end() ? -1 : it->second;
+}
+
+Node GraphSnapshot::node(int index) const {
+    const NodeTable& nodes = *state->nodes;
+    return Node(nodes.ids[index], nodes.xs[index], nodes.ys[index]);
+}
+
+double GraphSnapshot::edgeWeight(int fromId, int toId) const {
+    int from = indexOf(fromId);
+    int to = indexOf(toId);
+    double best = std::numeric_limits<double>::infinity();
+    if (from < 0 || to < 0) {
+        return best;
+    }
+    forEachEdge(from, [&](int target, double weight) {
+        if (target == to) {
+            best = std::min(best, weight);
+        }
+    });
+    return best;
+}
+
+size_t GraphSnapshot::sharedChunks(const GraphSnapshot& other) const {
+    size_t shared = 0;
+    size_t count = std::min(state->chunks.size(), other.state->chunks.size());
+    for (size_t c = 0; c < count; c++) {
+        if (state->chunks[c] == other.state->chunks[c]) {
+            shared++;
+        }
+    }
+    return shared;
+}
+
+PathResult GraphSnapshot::search(int startId, int goalId, Heuristic heuristic) const {
+    return search(startId, goalId, heuristic, SearchWorkspace::local());
+}
+
+PathResult GraphSnapshot::search(int startId, int goalId, Heuristic heuristic,
+                                 SearchWorkspace& workspace) const {
+    engine::IndexedHeapQueue pq(workspace.indexedHeap());
+    engine::DenseVisited visited(workspace);
+    return engine::withHeuristic(heuristic, [&](const auto& h) {
+        return engine::run(SnapshotView(*this), pq, visited, h, startId, goalId);
+    });
+}
+
+VersionedGraph::VersionedGraph(const Graph& graph) {
+    // The CSR snapshot supplies the dense numbering and the reachability index
+    CompactGraph compact(graph);
+    const int n = static_cast<int>(compact.nodeCount());
+
+    auto nodes = std::make_shared<GraphSnapshot::NodeTable>();
+    nodes->ids.resize(n);
+    nodes->xs.resize(n);
+    nodes->ys.resize(n);
+    nodes->index.reserve(n);
+    for (int i = 0; i < n; i++) {
+        nodes->ids[i] = compact.idOf(i);
+        nodes->xs[i] = compact.x(i);
+        nodes->ys[i] = compact.y(i);
+        nodes->index[nodes->ids[i]] = i;
+    }
+
+    auto version = std::make_shared<GraphSnapshot::Version>();
+    version->edges = compact.edgeCount();
+    version->nodes = std::move(nodes);
+    version->reach = std::make_shared<ReachabilityIndex>(compact.reachability());
+    for (int first = 0; first < n; first += GraphSnapshot::kChunkNodes) {
+        const int last = std::min(n, first + GraphSnapshot::kChunkNodes);
+        auto chunk = std::make_shared<GraphSnapshot::Chunk>();
+        const size_t base = compact.edgeBegin(first);
+        const size_t end = compact.edgeEnd(last - 1);
+        for (int i = first; i < last; i++) {
+            chunk->offsets.push_back(static_cast<uint32_t>(compact.edgeBegin(i) - base));
+        }
+        chunk->offsets.push_back(static_cast<uint32_t>(end - base));
+        for (size_t e = base; e < end; e++) {
+            chunk->targets.push_back(compact.edgeTarget(e));
+            chunk->weights.push_back(compact.edgeWeight(e));
+        }
+        version->chunks.push_back(std::move(chunk));
+    }
+    current = std::move(version);
+}
+
+GraphSnapshot VersionedGraph::snapshot() const {
+    return GraphSnapshot(std::atomic_load(&current));
+}
+
+int VersionedGraph::indexOf(int id) const {
+    // Only the writer stores current, so it may read it without atomic_load
+    const auto& index = current->nodes->index;
+    auto it = index.find(id);
+    if (it == index.end()) {
+        throw std::runtime_error("VersionedGraph: node not found: " + std::to_string(id));
+    }
+    return it->second;
+}
+
+GraphSnapshot::Chunk& VersionedGraph::stage(int index) {
+    const int c = index >> GraphSnapshot::kChunkBits;
+    auto it = staged.find(c);
+    if (it == staged.end()) {
+        it = staged.emplace(c, std::make_shared<GraphSnapshot::Chunk>(*current->chunks[c])).first;
+    }
+    return *it->second;
+}
+
+void VersionedGraph::setEdgeWeight(int fromId, int toId, double weight) {
+    const int from = indexOf(fromId);
+    const int to = indexOf(toId);
+    GraphSnapshot::Chunk& chunk = stage(from);
+    const int local = from & (GraphSnapshot::kChunkNodes - 1);
+    bool found = false;
+    for (uint32_t e = chunk.offsets[local]; e < chunk.offsets[local + 1]; e++) {
+        if (chunk.targets[e] == to) {
+            chunk.weights[e] = weight;
+            found = true;
+        }
+    }
+    if (!found) {
+        throw std::runtime_error("VersionedGraph: no edge " + std::to_string(fromId) + " -> " +
+                                 std::to_string(toId));
+    }
+}
+
+void VersionedGraph::removeEdge(int fromId, int toId) {
+    const int from = indexOf(fromId);
+    const int to = indexOf(toId);
+    GraphSnapshot::Chunk& chunk = stage(from);
+    const int local = from & (GraphSnapshot::kChunkNodes - 1);
+    const uint32_t begin = chunk.offsets[local];
+    const uint32_t end = chunk.offsets[local + 1];
+    uint32_t kept = begin;
+    for (uint32_t e = begin; e < end; e++) {
+        if (chunk.targets[e] != to) {
+            chunk.targets[kept] = chunk.targets[e];
+            chunk.weights[kept] = chunk.weights[e];
+            kept++;
+        }
+    }
+    const uint32_t removed = end - kept;
+    if (removed == 0) {
+        throw std::runtime_error("VersionedGraph: no edge " + std::to_string(fromId) + " -> " +
+                                 std::to_string(toId));
+    }
+    chunk.targets.erase(chunk.targets.begin() + kept, chunk.targets.begin() + end);
+    chunk.weights.erase(chunk.weights.begin() + kept, chunk.weights.begin() + end);
+    for (size_t i = local + 1; i < chunk.offsets.size(); i++) {
+        chunk.offsets[i] -= removed;
+    }
+    // Fewer edges never invalidate the reachability index
+    stagedEdges -= removed;
+}
+
+void VersionedGraph::addEdge(int fromId, int toId, double weight) {
+    const int from = indexOf(fromId);
+    const int to = indexOf(toId);
+    GraphSnapshot::Chunk& chunk = stage(from);
+    const int local = from & (GraphSnapshot::kChunkNodes - 1);
+    const uint32_t end = chunk.offsets[local + 1];
+    chunk.targets.insert(chunk.targets.begin() + end, to);
+    chunk.weights.insert(chunk.weights.begin() + end, weight);
+    for (size_t i = local + 1; i < chunk.offsets.size(); i++) {
+        chunk.offsets[i]++;
+    }
+    stagedEdges++;
+
+    const ReachabilityIndex& reach = stagedReach ? *stagedReach : *current->reach;
+    if (!reach.mayReach(from, to)) {
+        if (!stagedReach) {
+            stagedReach = std::make_shared<ReachabilityIndex>(*current->reach);
+        }
+        stagedReach->addEdge(from, to);
+    }
+}
+
+uint64_t VersionedGraph::publish() {
+    if (staged.empty() && !stagedReach) {
+        return current->number;
+    }
+    auto next = std::make_shared<GraphSnapshot::Version>(*current);
+    next->number++;
+    next->edges = static_cast<size_t>(static_cast<long long>(next->edges) + stagedEdges);
+    for (auto& [c, chunk] : staged) {
+        next->chunks[c] = std::move(chunk);
+    }
+    if (stagedReach) {
+        next->reach = std::move(stagedReach);
+    }
+    staged.clear();
+    stagedReach.reset();
+    stagedEdges = 0;
+
+    const uint64_t number = next->number;
+    std::atomic_store(&current, std::shared_ptr<const GraphSnapshot::Version>(std::move(next)));
+    return number;
+}
+
+} // namespace sf
@@ -2,6 +2,9 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <stdexcept>
+#include <atomic>
+#include <thread>
 
 void testGraphBasics() {
     std::cout << "Testing Graph Basics... ";
@@ -155,6 +158,17 @@ void testIDAStar() {
     
     assert(result.found);
     assert(result.path.size() == 4);
+    assert(std::abs(result.cost - 3.0) < 1e-9);
+    assert(sf::IDAStar::search(graph, 2, 2).path.size() == 1);
+    
+    // Long corridor: the explicit stack handles depths that would overflow recursion
+    sf::Graph corridor;
+    for (int i = 0; i < 200000; i++) {
+        corridor.addNode(sf::Node(i, i, 0));
+        if (i > 0) corridor.addEdgeUndirected(i - 1, i, 1.0);
+    }
+    auto deep = sf::IDAStar::search(corridor, 0, 199999);
+    assert(deep.found && deep.path.size() == 200000 && std::abs(deep.cost - 199999.0) < 1e-9);
     
     std::cout << "PASSED\n";
 }
@@ -260,6 +274,1823 @@ void testPathResultStructure() {
     std::cout << "PASSED\n";
 }
 
+void testCompactGraph() {
+    std::cout << "Testing CompactGraph... ";
+    
+    // 5x5 grid with sparse, non-contiguous ids
+    sf::Graph graph;
+    for (int i = 0; i < 25; i++) {
+        graph.addNode(sf::Node(i * 7 + 3, i % 5, i / 5));
+    }
+    for (int i = 0; i < 25; i++) {
+        if (i % 5 < 4) graph.addEdgeUndirected(i * 7 + 3, (i + 1) * 7 + 3, 1.0 + (i % 3));
+        if (i / 5 < 4) graph.addEdgeUndirected(i * 7 + 3, (i + 5) * 7 + 3, 1.0 + (i % 2));
+    }
+    
+    sf::CompactGraph compact = graph.freeze();
+    assert(compact.nodeCount() == graph.nodeCount());
+    assert(compact.edgeCount() == graph.edgeCount());
+    assert(compact.indexOf(3) == 0);
+    assert(compact.indexOf(4) == -1);
+    assert(compact.idOf(compact.indexOf(24 * 7 + 3)) == 24 * 7 + 3);
+    
+    int start = 3;
+    int goal = 24 * 7 + 3;
+    
+    auto dijkstra = sf::Dijkstra::search(graph, start, goal);
+    auto dijkstraCompact = sf::Dijkstra::search(compact, start, goal);
+    assert(dijkstraCompact.found);
+    assert(std::abs(dijkstraCompact.cost - dijkstra.cost) < 1e-9);
+    
+    auto astarCompact = sf::AStar::search(compact, start, goal);
+    assert(astarCompact.found);
+    assert(std::abs(astarCompact.cost - dijkstra.cost) < 1e-9);
+    assert(astarCompact.path.front() == start && astarCompact.path.back() == goal);
+    
+    auto idaCompact = sf::IDAStar::search(compact, start, goal);
+    assert(idaCompact.found);
+    assert(std::abs(idaCompact.cost - dijkstra.cost) < 1e-9);
+    
+    auto bfs = sf::BFS::search(graph, start, goal);
+    auto bfsCompact = sf::BFS::search(compact, start, goal);
+    assert(bfsCompact.found);
+    assert(bfsCompact.path.size() == bfs.path.size());
+    
+    assert(sf::DFS::search(compact, start, goal).found);
+    assert(sf::BestFirstSearch::search(compact, start, goal).found);
+    assert(!sf::AStar::search(compact, start, 4).found);
+    
+    std::cout << "PASSED\n";
+}
+
+void testSearchWorkspace() {
+    std::cout << "Testing SearchWorkspace... ";
+    
+    sf::Graph line;
+    for (int i = 0; i < 6; i++) {
+        line.addNode(sf::Node(i, i, 0));
+    }
+    for (int i = 0; i < 5; i++) {
+        line.addEdgeUndirected(i, i + 1, 1.0);
+    }
+    sf::CompactGraph compact = line.freeze();
+    
+    // One workspace reused across many queries must not leak state between them
+    sf::SearchWorkspace workspace;
+    for (int round = 0; round < 3; round++) {
+        for (int goal = 0; goal < 6; goal++) {
+            auto d = sf::Dijkstra::search(compact, 0, goal, workspace);
+            assert(d.found && d.cost == goal);
+            auto a = sf::AStar::search(compact, 5, goal, sf::heuristics::euclidean, workspace);
+            assert(a.found && a.cost == 5 - goal);
+            auto b = sf::BFS::search(compact, goal, 0, workspace);
+            assert(b.found && b.path.size() == static_cast<size_t>(goal + 1));
+        }
+    }
+    
+    // A short query only touches nodes near the start
+    auto shortHop = sf::Dijkstra::search(compact, 2, 3, workspace);
+    assert(shortHop.found && shortHop.nodesExplored <= 3);
+    
+    std::cout << "PASSED\n";
+}
+
+void testIndexedHeap() {
+    std::cout << "Testing IndexedDaryHeap... ";
+    
+    sf::IndexedDaryHeap<4> heap(10);
+    heap.push(3, 5.0);
+    heap.push(7, 2.0);
+    heap.push(1, 8.0);
+    heap.push(9, 4.0);
+    assert(heap.size() == 4);
+    assert(heap.top() == 7);
+    
+    heap.decreaseKey(1, 1.0);
+    assert(heap.top() == 1);
+    assert(!heap.pushOrDecrease(3, 6.0));
+    assert(heap.key(3) == 5.0);
+    
+    heap.remove(9);
+    assert(!heap.contains(9));
+    heap.update(7, 10.0);
+    
+    assert(heap.pop() == 1);
+    assert(heap.pop() == 3);
+    assert(heap.pop() == 7);
+    assert(heap.empty());
+    
+    heap.push(2, 1.0);
+    heap.clear();
+    assert(heap.empty() && !heap.contains(2));
+    
+    std::cout << "PASSED\n";
+}
+
+void testIntegerQueues() {
+    std::cout << "Testing Integer Priority Queues... ";
+    
+    sf::RadixHeap radix;
+    sf::BucketQueue buckets(4);
+    for (int v : {7, 3, 9, 3, 12, 100}) {
+        radix.push({static_cast<double>(v), v});
+        buckets.push({static_cast<double>(v), v});
+    }
+    for (int expected : {3, 3, 7, 9, 12, 100}) {
+        assert(radix.top().first == expected);
+        assert(buckets.top().first == expected);
+        radix.pop();
+        buckets.pop();
+    }
+    assert(radix.empty() && buckets.empty());
+    
+    // 8x8 grid with integer weights (Auto -> bucket queue) and quarter-unit
+    // fixed-point weights (scale 4)
+    for (double unit : {1.0, 0.25}) {
+        sf::Graph graph;
+        for (int i = 0; i < 64; i++) {
+            graph.addNode(sf::Node(i, (i % 8) * unit, (i / 8) * unit));
+        }
+        for (int i = 0; i < 64; i++) {
+            if (i % 8 < 7) graph.addEdgeUndirected(i, i + 1, unit * (1 + (i * 7) % 5));
+            if (i / 8 < 7) graph.addEdgeUndirected(i, i + 8, unit * (1 + (i * 3) % 4));
+        }
+        sf::CompactGraph compact = graph.freeze();
+        assert(compact.integerWeightScale() == 1.0 / unit);
+        assert(sf::resolveQueuePolicy(sf::QueuePolicy::Auto, compact) == sf::QueuePolicy::BucketQueue);
+        
+        sf::SearchWorkspace workspace;
+        for (int goal = 0; goal < 64; goal += 5) {
+            double expected = sf::Dijkstra::search(compact, 0, goal, workspace,
+                                                   sf::QueuePolicy::DaryHeap).cost;
+            for (auto policy : {sf::QueuePolicy::RadixHeap, sf::QueuePolicy::BucketQueue}) {
+                auto d = sf::Dijkstra::search(compact, 0, goal, workspace, policy);
+                assert(d.found && d.cost == expected);
+                auto a = sf::AStar::search(compact, 0, goal, sf::heuristics::euclidean,
+                                           workspace, policy);
+                assert(a.found && a.cost == expected);
+            }
+        }
+    }
+    
+    // Irrational weights cannot use integer queues
+    sf::Graph irrational;
+    irrational.addNode(sf::Node(0, 0, 0));
+    irrational.addNode(sf::Node(1, 1, 1));
+    irrational.addEdge(0, 1, std::sqrt(2.0));
+    sf::CompactGraph compact = irrational.freeze();
+    assert(compact.integerWeightScale() == 0.0);
+    assert(sf::resolveQueuePolicy(sf::QueuePolicy::Auto, compact) == sf::QueuePolicy::DaryHeap);
+    bool threw = false;
+    try {
+        sf::Dijkstra::search(compact, 0, 1, sf::SearchWorkspace::local(), sf::QueuePolicy::RadixHeap);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    std::cout << "PASSED\n";
+}
+
+// Sum of edge weights along a path, or -1 if some hop is not an edge
+double walkPath(const sf::Graph& graph, const std::vector<int>& path) {
+    double cost = 0.0;
+    for (size_t i = 1; i < path.size(); i++) {
+        double best = -1.0;
+        for (const auto& edge : graph.getNeighbors(path[i - 1])) {
+            if (edge.to == path[i] && (best < 0 || edge.weight < best)) {
+                best = edge.weight;
+            }
+        }
+        if (best < 0) {
+            return -1.0;
+        }
+        cost += best;
+    }
+    return cost;
+}
+
+// Directed 10x10 grid: one-way rows alternate direction, columns are two-way.
+// Weights are at least the euclidean distance so the heuristic stays consistent.
+sf::Graph makeDirectedGrid() {
+    sf::Graph graph;
+    for (int i = 0; i < 100; i++) {
+        graph.addNode(sf::Node(i, i % 10, i / 10));
+    }
+    for (int i = 0; i < 100; i++) {
+        int row = i / 10;
+        if (i % 10 < 9) {
+            if (row % 2 == 0) graph.addEdge(i, i + 1, 1.0 + (i * 13) % 4);
+            else graph.addEdge(i + 1, i, 1.0 + (i * 7) % 3);
+        }
+        if (row < 9) graph.addEdgeUndirected(i, i + 10, 1.0 + (i * 5) % 3);
+    }
+    return graph;
+}
+
+// makeDirectedGrid plus node 100, which no edge reaches
+sf::Graph makePlannerGrid() {
+    sf::Graph graph = makeDirectedGrid();
+    graph.addNode(sf::Node(100, 20, 20));
+    return graph;
+}
+
+// Every edge of graph, to mirror the costs given to an incremental planner
+std::vector<sf::Edge> edgeList(const sf::Graph& graph) {
+    std::vector<sf::Edge> edges;
+    for (int id : graph.getNodeIds()) {
+        for (const auto& edge : graph.getNeighbors(id)) {
+            edges.push_back(edge);
+        }
+    }
+    return edges;
+}
+
+// Set every mirrored from -> to edge, as the planners' cost updates do
+void setMirroredCost(std::vector<sf::Edge>& edges, int from, int to, double weight) {
+    for (auto& edge : edges) {
+        if (edge.from == from && edge.to == to) edge.weight = weight;
+    }
+}
+
+// Dijkstra over the nodes of grid and the mirrored edges; infinite ones are left out
+sf::PathResult referenceSearch(const sf::Graph& grid, const std::vector<sf::Edge>& edges,
+                               int start, int goal) {
+    sf::Graph current;
+    for (const auto& [id, node] : grid.getNodes()) {
+        current.addNode(node);
+    }
+    for (const auto& edge : edges) {
+        if (edge.weight != std::numeric_limits<double>::infinity()) {
+            current.addEdge(edge.from, edge.to, edge.weight);
+        }
+    }
+    return sf::Dijkstra::search(current, start, goal);
+}
+
+// Small LCG for the randomized planner walks, in [0, 1000)
+unsigned nextRandom(unsigned& seed) {
+    seed = seed * 1103515245u + 12345u;
+    return (seed >> 8) % 1000;
+}
+
+void testBidirectional() {
+    std::cout << "Testing Bidirectional Dijkstra / A*... ";
+    
+    sf::Graph graph = makeDirectedGrid();
+    sf::CompactGraph compact = graph.freeze();
+    
+    for (int start = 0; start < 100; start += 7) {
+        for (int goal = 0; goal < 100; goal += 11) {
+            auto expected = sf::Dijkstra::search(compact, start, goal);
+            auto bd = sf::BidirectionalDijkstra::search(compact, start, goal);
+            auto ba = sf::BidirectionalAStar::search(compact, start, goal);
+            assert(bd.found == expected.found && ba.found == expected.found);
+            if (!expected.found) continue;
+            assert(std::abs(bd.cost - expected.cost) < 1e-9);
+            assert(std::abs(ba.cost - expected.cost) < 1e-9);
+            assert(bd.path.front() == start && bd.path.back() == goal);
+            assert(ba.path.front() == start && ba.path.back() == goal);
+            assert(std::abs(walkPath(graph, bd.path) - expected.cost) < 1e-9);
+            assert(std::abs(walkPath(graph, ba.path) - expected.cost) < 1e-9);
+        }
+    }
+    
+    // Plain Graph overloads and disconnected endpoints
+    assert(sf::BidirectionalDijkstra::search(graph, 0, 99).found);
+    graph.addNode(sf::Node(100, 50, 50));
+    assert(!sf::BidirectionalAStar::search(graph, 0, 100).found);
+    assert(sf::BidirectionalDijkstra::search(graph, 100, 100).path.size() == 1);
+    
+    std::cout << "PASSED\n";
+}
+
+void testContractionHierarchy() {
+    std::cout << "Testing Contraction Hierarchy... ";
+    
+    sf::Graph graph = makeDirectedGrid();
+    // A few long-range one-way links to create non-trivial shortcuts
+    graph.addEdge(0, 55, 9.0);
+    graph.addEdge(97, 12, 11.0);
+    graph.addEdge(40, 49, 8.5);
+    sf::CompactGraph compact = graph.freeze();
+    
+    sf::ContractionOptions options;
+    options.threads = 2;
+    sf::ContractionHierarchy ch(graph, options);
+    assert(ch.nodeCount() == 100);
+    assert(ch.rank(0) >= 0 && ch.rank(1000) == -1);
+    
+    for (int start = 0; start < 100; start += 3) {
+        for (int goal = 0; goal < 100; goal += 7) {
+            auto expected = sf::Dijkstra::search(compact, start, goal);
+            auto result = ch.search(start, goal);
+            assert(result.found == expected.found);
+            if (!expected.found) continue;
+            assert(std::abs(result.cost - expected.cost) < 1e-9);
+            assert(result.path.front() == start && result.path.back() == goal);
+            assert(std::abs(walkPath(graph, result.path) - expected.cost) < 1e-9);
+        }
+    }
+    
+    // Rounds are picked by priority and id only, so any thread count builds
+    // the same hierarchy
+    options.threads = 1;
+    sf::ContractionHierarchy serial(graph, options);
+    assert(serial.shortcutCount() == ch.shortcutCount());
+    for (int id = 0; id < 100; id++) {
+        assert(serial.rank(id) == ch.rank(id));
+    }
+    
+    graph.addNode(sf::Node(100, 20, 20));
+    sf::ContractionHierarchy withIsland(graph);
+    assert(!withIsland.search(0, 100).found);
+    assert(withIsland.search(100, 100).found);
+    
+    std::cout << "PASSED\n";
+}
+
+void testLandmarks() {
+    std::cout << "Testing ALT Landmarks... ";
+    
+    sf::Graph graph = makeDirectedGrid();
+    sf::CompactGraph compact = graph.freeze();
+    
+    for (auto selection : {sf::LandmarkSelection::Farthest, sf::LandmarkSelection::Avoid}) {
+        sf::LandmarkOptions options;
+        options.count = 4;
+        options.selection = selection;
+        options.threads = 2;
+        sf::Landmarks landmarks(compact, options);
+        assert(landmarks.count() == 4);
+        assert(landmarks.landmarkIds().size() == 4);
+        assert(landmarks.memoryBytes() == 2 * 100 * 4 * sizeof(float));
+        
+        sf::Heuristic alt = landmarks.heuristic();
+        size_t altExplored = 0;
+        size_t zeroExplored = 0;
+        for (int start = 0; start < 100; start += 3) {
+            for (int goal = 0; goal < 100; goal += 7) {
+                auto expected = sf::Dijkstra::search(compact, start, goal);
+                assert(landmarks.lowerBound(start, goal) <= expected.cost + 1e-9);
+                
+                auto result = sf::AStar::search(compact, start, goal, alt);
+                assert(result.found && std::abs(result.cost - expected.cost) < 1e-6);
+                altExplored += result.nodesExplored;
+                zeroExplored += sf::AStar::search(compact, start, goal,
+                                                  sf::heuristics::zero).nodesExplored;
+            }
+        }
+        assert(altExplored < zeroExplored);
+    }
+    
+    // Explicit landmarks; the heuristic outlives the Landmarks object
+    sf::Heuristic corners;
+    {
+        sf::Landmarks explicitLandmarks(compact, std::vector<int>{0, 9, 90, 99, 12345});
+        assert(explicitLandmarks.count() == 4);
+        corners = explicitLandmarks.heuristic();
+    }
+    auto expected = sf::Dijkstra::search(graph, 5, 94);
+    assert(std::abs(sf::IDAStar::search(compact, 5, 94, corners).cost - expected.cost) < 1e-6);
+    assert(std::abs(sf::AStar::search(graph, 5, 94, corners).cost - expected.cost) < 1e-6);
+    assert(corners(graph.getNode(5), graph.getNode(5)) == 0.0);
+    
+    sf::Landmarks empty;
+    assert(empty.count() == 0 && empty.lowerBound(0, 1) == 0.0);
+    
+    std::cout << "PASSED\n";
+}
+
+void testSearchEngine() {
+    std::cout << "Testing Search Engine / Weighted A*... ";
+    
+    sf::Graph graph = makeDirectedGrid();
+    sf::CompactGraph compact = graph.freeze();
+    
+    for (int start = 0; start < 100; start += 11) {
+        for (int goal = 3; goal < 100; goal += 13) {
+            auto optimal = sf::Dijkstra::search(compact, start, goal);
+            sf::SearchWorkspace heapWorkspace;
+            auto astar = sf::AStar::search(compact, start, goal, sf::heuristics::euclidean,
+                                           heapWorkspace, sf::QueuePolicy::DaryHeap);
+            
+            auto unweighted = sf::WeightedAStar::search(compact, start, goal, 1.0);
+            assert(std::abs(unweighted.cost - optimal.cost) < 1e-9);
+            assert(unweighted.nodesExplored == astar.nodesExplored);
+            
+            auto weighted = sf::WeightedAStar::search(graph, start, goal, 2.5);
+            assert(weighted.found && weighted.cost <= 2.5 * optimal.cost + 1e-9);
+            assert(std::abs(walkPath(graph, weighted.path) - weighted.cost) < 1e-9);
+            
+            // A custom instantiation: inlined lambda heuristic over the dense graph
+            sf::SearchWorkspace workspace;
+            sf::engine::IndexedHeapQueue pq(workspace.indexedHeap());
+            sf::engine::DenseVisited visited(workspace);
+            auto chebyshev = [](const sf::Node& a, const sf::Node& b) {
+                return std::max(std::abs(a.x - b.x), std::abs(a.y - b.y));
+            };
+            auto custom = sf::engine::run(sf::engine::CompactGraphView(compact), pq, visited,
+                                          chebyshev, start, goal);
+            assert(std::abs(custom.cost - optimal.cost) < 1e-9);
+        }
+    }
+    
+    // Graph and CompactGraph instantiations agree
+    auto bfsGraph = sf::BFS::search(graph, 0, 99);
+    auto bfsCompact = sf::BFS::search(compact, 0, 99);
+    assert(bfsGraph.path.size() == bfsCompact.path.size());
+    assert(sf::BestFirstSearch::search(graph, 0, 99).found);
+    assert(!sf::WeightedAStar::search(graph, 0, 12345, 2.0).found);
+    
+    std::cout << "PASSED\n";
+}
+
+void testThreadPool() {
+    std::cout << "Testing Thread Pool... ";
+    
+    sf::ThreadPool pool(4);
+    assert(pool.size() == 4);
+    
+    // Every index runs exactly once, also with uneven task costs that force stealing
+    for (size_t grain : {1, 3, 64}) {
+        std::vector<int> hits(1000, 0);
+        std::vector<size_t> perWorker(pool.size(), 0);
+        pool.parallelFor(hits.size(), [&](size_t i, size_t worker) {
+            hits[i]++;
+            perWorker[worker]++;
+            if (i < 50) {
+                volatile double spin = 0.0;
+                for (int k = 0; k < 20000; k++) spin = spin + k;
+            }
+        }, grain);
+        for (int h : hits) assert(h == 1);
+        size_t total = 0;
+        for (size_t n : perWorker) total += n;
+        assert(total == hits.size());
+    }
+    
+    bool threw = false;
+    try {
+        pool.parallelFor(100, [](size_t i, size_t) {
+            if (i == 42) throw std::runtime_error("task failed");
+        });
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    size_t count = 0;
+    pool.parallelFor(10, [&](size_t, size_t) { count++; }, 100);  // runs inline
+    assert(count == 10);
+    
+    std::cout << "PASSED\n";
+}
+
+void testBatchPlanner() {
+    std::cout << "Testing Batch Planner... ";
+    
+    sf::Graph graph = makeDirectedGrid();
+    sf::CompactGraph compact = graph.freeze();
+    
+    const sf::PlanAlgorithm algorithms[] = {
+        sf::PlanAlgorithm::BFS, sf::PlanAlgorithm::DFS, sf::PlanAlgorithm::Dijkstra,
+        sf::PlanAlgorithm::BestFirst, sf::PlanAlgorithm::AStar,
+        sf::PlanAlgorithm::BidirectionalDijkstra, sf::PlanAlgorithm::BidirectionalAStar};
+    std::vector<sf::PlanRequest> requests;
+    for (int i = 0; i < 300; i++) {
+        requests.emplace_back((i * 37) % 100, (i * 53 + 7) % 100, algorithms[i % 7]);
+    }
+    requests.emplace_back(0, 12345, sf::PlanAlgorithm::AStar);
+    
+    sf::BatchPlanner planner(compact, 3);
+    assert(planner.threads() == 3);
+    std::vector<sf::PathResult> results;
+    for (int round = 0; round < 2; round++) {
+        sf::BatchStats stats = planner.run(requests, results);
+        assert(results.size() == requests.size());
+        assert(stats.queries == requests.size() && stats.threads == 3);
+        assert(stats.found == requests.size() - 1);
+        
+        size_t explored = 0;
+        for (size_t i = 0; i < requests.size(); i++) {
+            explored += results[i].nodesExplored;
+            const auto& r = requests[i];
+            if (!results[i].found) {
+                assert(r.goalId == 12345);
+                continue;
+            }
+            assert(results[i].path.front() == r.startId && results[i].path.back() == r.goalId);
+            assert(std::abs(walkPath(graph, results[i].path) - results[i].cost) < 1e-9);
+            if (r.algorithm == sf::PlanAlgorithm::Dijkstra ||
+                r.algorithm == sf::PlanAlgorithm::AStar ||
+                r.algorithm == sf::PlanAlgorithm::BidirectionalDijkstra) {
+                auto expected = sf::Dijkstra::search(graph, r.startId, r.goalId);
+                assert(std::abs(results[i].cost - expected.cost) < 1e-9);
+            }
+        }
+        assert(stats.nodesExplored == explored);
+    }
+    
+    // Owned snapshot of a Graph, single worker, raw arrays
+    sf::BatchPlanner sequential(graph, 1);
+    std::vector<sf::PathResult> raw(2);
+    sf::PlanRequest pair[] = {{0, 99, sf::PlanAlgorithm::Dijkstra}, {99, 0, sf::PlanAlgorithm::BFS}};
+    assert(sequential.run(pair, 2, raw.data()).found == 2);
+    assert(std::abs(raw[0].cost - sf::Dijkstra::search(graph, 0, 99).cost) < 1e-9);
+    
+    std::cout << "PASSED\n";
+}
+
+void testDistanceMatrix() {
+    std::cout << "Testing Distance Matrix... ";
+    
+    sf::Graph graph = makeDirectedGrid();
+    graph.addNode(sf::Node(100, 20, 20));  // unreachable island
+    sf::CompactGraph compact = graph.freeze();
+    sf::ContractionHierarchy ch(compact);
+    
+    std::vector<int> sources = {0, 17, 55, 99, 100, 4242, 17};
+    std::vector<int> targets = {3, 99, 3, 60, 100, 0, 4242};
+    
+    auto matrix = sf::DistanceMatrix<double>::compute(compact, sources, targets, 2);
+    auto single = sf::DistanceMatrix<float>::compute(graph, sources, targets, 1);
+    auto viaCH = sf::DistanceMatrix<double>::compute(ch, sources, targets, 2);
+    assert(matrix.rows() == sources.size() && matrix.cols() == targets.size());
+    
+    for (size_t i = 0; i < sources.size(); i++) {
+        for (size_t j = 0; j < targets.size(); j++) {
+            auto expected = sf::Dijkstra::search(compact, sources[i], targets[j]);
+            if (!expected.found) {
+                assert(std::isinf(matrix(i, j)) && std::isinf(single(i, j)) &&
+                       std::isinf(viaCH(i, j)));
+                continue;
+            }
+            assert(std::abs(matrix(i, j) - expected.cost) < 1e-9);
+            assert(std::abs(viaCH(i, j) - expected.cost) < 1e-9);
+            assert(std::abs(single(i, j) - expected.cost) < 1e-4);
+        }
+    }
+    assert(matrix.row(2)[1] == matrix(2, 1));
+    
+    auto empty = sf::DistanceMatrix<double>::compute(compact, {}, targets);
+    assert(empty.rows() == 0 && empty.cols() == targets.size());
+    
+    std::cout << "PASSED\n";
+}
+
+void testDeltaStepping() {
+    std::cout << "Testing Delta-Stepping... ";
+    
+    sf::Graph graph = makeDirectedGrid();
+    graph.addEdge(0, 77, 2.5);   // a heavy shortcut
+    graph.addEdge(5, 6, 0.0);    // zero-weight edge
+    graph.addNode(sf::Node(100, 20, 20));
+    sf::CompactGraph compact = graph.freeze();
+    
+    for (size_t threads : {1, 3}) {
+        for (double delta : {0.0, 0.5, 2.0, 100.0}) {
+            sf::DeltaStepping sssp(threads, delta);
+            assert(sssp.threads() == threads);
+            assert(sssp.bucketWidth(compact) > 0.0);
+            
+            sf::ShortestPathTree tree = sssp.run(graph, 0);
+            assert(tree.sourceId == 0 && tree.ids.size() == 101);
+            assert(tree.distanceTo(0) == 0.0 && tree.pathTo(0).size() == 1);
+            assert(!tree.reached(100) && tree.pathTo(100).empty());
+            assert(std::isinf(tree.distanceTo(4242)));
+            for (int goal = 0; goal < 100; goal++) {
+                auto expected = sf::Dijkstra::search(compact, 0, goal);
+                assert(std::abs(tree.distanceTo(goal) - expected.cost) < 1e-9);
+                auto path = tree.pathTo(goal);
+                assert(path.front() == 0 && path.back() == goal);
+                assert(std::abs(walkPath(graph, path) - expected.cost) < 1e-9);
+            }
+            
+            for (int goal = 3; goal < 100; goal += 19) {
+                auto expected = sf::Dijkstra::search(compact, 42, goal);
+                auto result = sssp.search(compact, 42, goal);
+                assert(result.found && std::abs(result.cost - expected.cost) < 1e-9);
+                assert(std::abs(walkPath(graph, result.path) - expected.cost) < 1e-9);
+            }
+            assert(!sssp.search(graph, 0, 100).found);
+        }
+    }
+    
+    // Distances far beyond the bucket ring wrap around it many times; the
+    // infinite edge does not widen the ring
+    sf::Graph line;
+    for (int i = 0; i < 500; i++) {
+        line.addNode(sf::Node(i, i, 0));
+        if (i > 0) line.addEdge(i - 1, i, 1.0 + (i % 3) * 0.25);
+    }
+    line.addEdge(0, 499, std::numeric_limits<double>::infinity());
+    line.addEdge(0, 250, 400.0);
+    sf::CompactGraph compactLine = line.freeze();
+    for (double delta : {0.0, 0.3, 1.0}) {
+        sf::DeltaStepping sssp(2, delta);
+        sf::ShortestPathTree tree = sssp.run(compactLine, 0);
+        for (int goal = 0; goal < 500; goal += 37) {
+            auto expected = sf::Dijkstra::search(compactLine, 0, goal);
+            assert(std::abs(tree.distanceTo(goal) - expected.cost) < 1e-9);
+        }
+        assert(std::abs(sssp.search(compactLine, 0, 499).cost -
+                        sf::Dijkstra::search(compactLine, 0, 499).cost) < 1e-9);
+    }
+    
+    std::cout << "PASSED\n";
+}
+
+// Serial reference hop counts over a CompactGraph
+std::vector<int> referenceHops(const sf::CompactGraph& graph, int source) {
+    std::vector<int> hops(graph.nodeCount(), -1);
+    std::vector<int> queue{source};
+    hops[source] = 0;
+    for (size_t i = 0; i < queue.size(); i++) {
+        int u = queue[i];
+        for (size_t e = graph.edgeBegin(u); e < graph.edgeEnd(u); e++) {
+            int v = graph.edgeTarget(e);
+            if (hops[v] < 0) {
+                hops[v] = hops[u] + 1;
+                queue.push_back(v);
+            }
+        }
+    }
+    return hops;
+}
+
+void testParallelBFS() {
+    std::cout << "Testing Parallel BFS... ";
+    
+    sf::Graph grid = makeDirectedGrid();
+    grid.addNode(sf::Node(100, 20, 20));
+    sf::CompactGraph compactGrid = grid.freeze();
+    
+    // Random digraph dense enough to trigger bottom-up levels
+    sf::Graph dense;
+    const int n = 3000;
+    for (int i = 0; i < n; i++) {
+        dense.addNode(sf::Node(i * 2, i % 50, i / 50));
+    }
+    unsigned seed = 12345;
+    for (int i = 0; i < n * 12; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int from = (seed >> 8) % n;
+        seed = seed * 1103515245u + 12345u;
+        int to = (seed >> 8) % n;
+        dense.addEdge(from * 2, to * 2, 1.0);
+    }
+    sf::CompactGraph compactDense = dense.freeze();
+    
+    for (size_t threads : {1, 3}) {
+        sf::ParallelBFS bfs(threads);
+        assert(bfs.threads() == threads);
+        
+        sf::HopTree tree = bfs.run(grid, 0);
+        std::vector<int> expected = referenceHops(compactGrid, 0);
+        assert(tree.sourceId == 0 && tree.ids.size() == 101);
+        assert(tree.reached == 100 && tree.hopsTo(100) == -1 && tree.pathTo(100).empty());
+        assert(tree.hopsTo(4242) == -1);
+        for (int goal = 0; goal < 100; goal++) {
+            assert(tree.hopsTo(goal) == expected[goal]);
+            auto path = tree.pathTo(goal);
+            assert(path.front() == 0 && path.back() == goal);
+            assert(static_cast<int>(path.size()) == expected[goal] + 1);
+            assert(std::isfinite(walkPath(grid, path)));
+        }
+        
+        sf::HopTree denseTree = bfs.run(compactDense, 10);
+        expected = referenceHops(compactDense, compactDense.indexOf(10));
+        assert(denseTree.bottomUpLevels > 0 && denseTree.bottomUpLevels < denseTree.levels);
+        size_t reached = 0;
+        for (int v = 0; v < n; v++) {
+            assert(denseTree.hopsTo(v * 2) == expected[v]);
+            reached += expected[v] >= 0;
+            if (expected[v] > 0) {
+                auto path = denseTree.pathTo(v * 2);
+                assert(static_cast<int>(path.size()) == expected[v] + 1);
+                assert(std::isfinite(walkPath(dense, path)));
+            }
+        }
+        assert(denseTree.reached == reached);
+        
+        // alpha = 0 keeps every level top-down
+        sf::ParallelBFS topDown(threads, 0.0);
+        assert(topDown.run(compactDense, 10).bottomUpLevels == 0);
+        assert(topDown.run(compactDense, 10).hops == denseTree.hops);
+        
+        for (int goal = 3; goal < 100; goal += 19) {
+            auto reference = sf::BFS::search(compactGrid, 42, goal);
+            auto result = bfs.search(grid, 42, goal);
+            assert(result.found && result.path.size() == reference.path.size());
+            assert(result.path.front() == 42 && result.path.back() == goal);
+            assert(std::abs(walkPath(grid, result.path) - result.cost) < 1e-9);
+            assert(result.nodesExplored <= tree.ids.size());
+        }
+        assert(!bfs.search(grid, 0, 100).found);
+        assert(!bfs.search(grid, 0, 4242).found);
+        assert(bfs.search(compactDense, 10, 10).path.size() == 1);
+    }
+    
+    std::cout << "PASSED\n";
+}
+
+void testMultiSourceBFS() {
+    std::cout << "Testing Multi-Source BFS... ";
+    
+    sf::Graph graph = makeDirectedGrid();
+    graph.addNode(sf::Node(100, 20, 20));
+    sf::CompactGraph compact = graph.freeze();
+    
+    // 103 sources: an isolated node, a duplicate and an unknown id
+    std::vector<int> sources;
+    for (int i = 0; i < 100; i++) {
+        sources.push_back((i * 37) % 100);
+    }
+    sources.push_back(100);
+    sources.push_back(sources[5]);
+    sources.push_back(4242);
+    
+    for (size_t threads : {1, 3}) {
+        for (size_t width : {64, 128, 256}) {
+            sf::MultiSourceBFS msbfs(threads, width);
+            assert(msbfs.threads() == threads && msbfs.batchWidth() == width);
+            sf::HopTable table = msbfs.run(graph, sources);
+            assert(table.rows() == sources.size() && table.cols() == 101);
+            assert(table.sourceIds() == sources);
+            assert(table.memoryBytes() == sources.size() * 101 * sizeof(uint16_t));
+            
+            for (size_t r = 0; r < sources.size(); r++) {
+                int s = compact.indexOf(sources[r]);
+                std::vector<int> expected = s < 0 ? std::vector<int>(101, -1)
+                                                  : referenceHops(compact, s);
+                for (int v = 0; v < 101; v++) {
+                    assert(table.hopsTo(r, compact.idOf(v)) == expected[v]);
+                    assert((table(r, v) == sf::HopTable::unreachable) == (expected[v] < 0));
+                }
+            }
+            assert(table.hopsTo(0, 4242) == -1);
+            assert(table.hopsTo(100, 100) == 0 && table.hopsTo(100, 0) == -1);
+            assert(table.hopsTo(999, 0) == -1);
+            assert(table.column(7)[5] == table(5, 7));
+        }
+    }
+    
+    // Hop counts beyond the 16-bit table are rejected
+    sf::Graph chain;
+    for (int i = 0; i < 70000; i++) {
+        chain.addNode(sf::Node(i, i, 0));
+        if (i > 0) chain.addEdge(i - 1, i, 1.0);
+    }
+    bool threw = false;
+    try {
+        sf::MultiSourceBFS(1).run(chain, {0});
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(sf::MultiSourceBFS(1).run(chain, {10000}).hopsTo(0, 69999) == 59999);
+    assert(sf::MultiSourceBFS(2).run(chain, {}).rows() == 0);
+    threw = false;
+    try {
+        sf::MultiSourceBFS(1, 100);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    std::cout << "PASSED\n";
+}
+
+void testARAStar() {
+    std::cout << "Testing ARA*... ";
+    
+    // 40x40 grid with a wall that has one gap, weights >= euclidean
+    sf::Graph graph;
+    const int side = 40;
+    for (int i = 0; i < side * side; i++) {
+        graph.addNode(sf::Node(i, i % side, i / side));
+    }
+    auto blocked = [&](int i) { return i % side == 20 && i / side != 35; };
+    for (int i = 0; i < side * side; i++) {
+        if (blocked(i)) continue;
+        if (i % side + 1 < side && !blocked(i + 1)) {
+            graph.addEdgeUndirected(i, i + 1, 1.0 + (i * 7) % 3);
+        }
+        if (i / side + 1 < side && !blocked(i + side)) {
+            graph.addEdgeUndirected(i, i + side, 1.0 + (i * 11) % 4);
+        }
+    }
+    graph.addNode(sf::Node(9999, 100, 100));
+    sf::CompactGraph compact = graph.freeze();
+    const int start = 5 * side + 2;
+    const int goal = 6 * side + 37;
+    double optimal = sf::Dijkstra::search(compact, start, goal).cost;
+    
+    sf::ARAStarOptions options;
+    options.initialEpsilon = 5.0;
+    options.epsilonStep = 1.0;
+    std::vector<double> costs;
+    std::vector<double> bounds;
+    options.onSolution = [&](const sf::PathResult& result, double bound) {
+        assert(result.found && result.path.front() == start && result.path.back() == goal);
+        assert(std::abs(walkPath(graph, result.path) - result.cost) < 1e-9);
+        assert(bound >= 1.0 && result.cost <= bound * optimal + 1e-9);
+        costs.push_back(result.cost);
+        bounds.push_back(bound);
+    };
+    
+    auto result = sf::ARAStar::search(graph, start, goal, options);
+    assert(result.found && std::abs(result.cost - optimal) < 1e-9);
+    assert(costs.size() >= 2 && bounds.back() == 1.0);
+    assert(std::abs(costs.back() - result.cost) < 1e-9);
+    for (size_t i = 1; i < costs.size(); i++) {
+        assert(costs[i] <= costs[i - 1] + 1e-9);
+    }
+    
+    // Reusing state beats restarting weighted A* at every epsilon
+    size_t restarted = 0;
+    for (double w = 5.0; w > 1.0; w -= 1.0) {
+        restarted += sf::WeightedAStar::search(compact, start, goal, w).nodesExplored;
+    }
+    restarted += sf::AStar::search(compact, start, goal, sf::heuristics::euclidean,
+                                   sf::SearchWorkspace::local(),
+                                   sf::QueuePolicy::DaryHeap).nodesExplored;
+    assert(result.nodesExplored < restarted);
+    
+    // epsilon 1 is plain A*: a single optimal solution
+    costs.clear();
+    bounds.clear();
+    options.initialEpsilon = 1.0;
+    result = sf::ARAStar::search(compact, start, goal, options);
+    assert(costs.size() == 1 && bounds[0] == 1.0 && std::abs(result.cost - optimal) < 1e-9);
+    
+    // A deadline in the past stops before the first solution
+    costs.clear();
+    options.initialEpsilon = 5.0;
+    options.deadline = sf::ARAStarOptions::Clock::now();
+    assert(!sf::ARAStar::search(compact, start, goal, options).found && costs.empty());
+    
+    options.deadline = sf::ARAStarOptions::Clock::time_point::max();
+    assert(!sf::ARAStar::search(compact, start, 9999, options).found && costs.empty());
+    assert(!sf::ARAStar::search(graph, start, 4242, options).found);
+    
+    // The reported cost is g(goal), which takes the cheaper of parallel edges
+    sf::Graph parallel;
+    for (int i = 0; i < 3; i++) {
+        parallel.addNode(sf::Node(i, i, 0));
+    }
+    parallel.addEdge(0, 1, 5.0);
+    parallel.addEdge(0, 1, 1.0);
+    parallel.addEdge(1, 2, 1.0);
+    auto cheaper = sf::ARAStar::search(parallel, 0, 2, sf::ARAStarOptions());
+    assert(cheaper.found && cheaper.cost == 2.0);
+    
+    std::cout << "PASSED\n";
+}
+
+void testResumableSearch() {
+    std::cout << "Testing Resumable Search... ";
+    
+    sf::Graph graph = makeDirectedGrid();
+    graph.addNode(sf::Node(100, 20, 20));
+    sf::CompactGraph compact = graph.freeze();
+    
+    using sf::PlanAlgorithm;
+    using sf::SearchStatus;
+    for (PlanAlgorithm algorithm : {PlanAlgorithm::BFS, PlanAlgorithm::DFS,
+                                    PlanAlgorithm::Dijkstra, PlanAlgorithm::BestFirst,
+                                    PlanAlgorithm::AStar}) {
+        // Same policies as the Graph overloads, so the expansions match exactly
+        sf::PathResult expected;
+        switch (algorithm) {
+            case PlanAlgorithm::BFS: expected = sf::BFS::search(graph, 3, 96); break;
+            case PlanAlgorithm::DFS: expected = sf::DFS::search(graph, 3, 96); break;
+            case PlanAlgorithm::Dijkstra: expected = sf::Dijkstra::search(graph, 3, 96); break;
+            case PlanAlgorithm::BestFirst:
+                expected = sf::BestFirstSearch::search(graph, 3, 96);
+                break;
+            default: expected = sf::AStar::search(graph, 3, 96); break;
+        }
+        
+        sf::ResumableSearch search(compact, 3, 96, algorithm);
+        size_t steps = 1;
+        while (search.step(3) == SearchStatus::Running) {
+            assert(search.nodesExplored() == 3 * steps && !search.result().found);
+            steps++;
+        }
+        assert(search.status() == SearchStatus::Found);
+        auto result = search.result();
+        assert(result.path == expected.path && result.cost == expected.cost);
+        assert(result.nodesExplored == expected.nodesExplored);
+        assert(search.nodesExplored() == expected.nodesExplored);
+        assert(steps == (expected.nodesExplored + 2) / 3);
+        assert(search.step(10) == SearchStatus::Found);
+    }
+    
+    // Two interleaved searches on their own workspaces
+    sf::SearchWorkspace first;
+    sf::SearchWorkspace second;
+    sf::ResumableSearch a(compact, 0, 99, PlanAlgorithm::AStar, sf::heuristics::euclidean, first);
+    sf::ResumableSearch b(compact, 99, 0, PlanAlgorithm::Dijkstra, sf::heuristics::zero, second);
+    while (a.status() == SearchStatus::Running || b.status() == SearchStatus::Running) {
+        a.step(5);
+        b.step(5);
+    }
+    assert(a.status() == SearchStatus::Found && b.status() == SearchStatus::Found);
+    assert(std::abs(a.result().cost - sf::Dijkstra::search(compact, 0, 99).cost) < 1e-9);
+    assert(std::abs(b.result().cost - sf::Dijkstra::search(compact, 99, 0).cost) < 1e-9);
+    
+    // The search keeps its own copy of a custom heuristic
+    sf::ResumableSearch custom(compact, 0, 99, PlanAlgorithm::AStar,
+                               [](const sf::Node& p, const sf::Node& q) { return p.distance(q); });
+    assert(custom.step(1) == SearchStatus::Running);
+    custom.stepFor(std::chrono::seconds(0));
+    assert(custom.nodesExplored() <= 257);
+    assert(custom.stepFor(std::chrono::seconds(10)) == SearchStatus::Found);
+    assert(std::abs(custom.result().cost - a.result().cost) < 1e-9);
+    
+    // Moves keep the state
+    sf::ResumableSearch moved = std::move(custom);
+    assert(moved.status() == SearchStatus::Found && moved.result().found);
+    
+    sf::ResumableSearch unreachable(compact, 0, 100, PlanAlgorithm::BFS);
+    assert(unreachable.finish() == SearchStatus::Failed && !unreachable.result().found);
+    assert(unreachable.nodesExplored() == 0);  // rejected by the reachability index
+    sf::ResumableSearch unknown(compact, 0, 4242);
+    assert(unknown.status() == SearchStatus::Failed && unknown.step(1) == SearchStatus::Failed);
+    
+    bool threw = false;
+    try {
+        sf::ResumableSearch(compact, 0, 99, PlanAlgorithm::BidirectionalDijkstra);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    std::cout << "PASSED\n";
+}
+
+void testIDAStarOptions() {
+    std::cout << "Testing IDA* table / threads... ";
+    
+    // Every table size and thread count returns the optimum
+    sf::Graph grid = makePlannerGrid();
+    sf::CompactGraph compact = grid.freeze();
+    for (size_t tableEntries : {size_t(0), size_t(16), size_t(1) << 16}) {
+        for (size_t threads : {1, 3}) {
+            sf::IDAStarOptions options;
+            options.tableEntries = tableEntries;
+            options.threads = threads;
+            for (int goal = 7; goal < 100; goal += 23) {
+                auto expected = sf::Dijkstra::search(compact, 90, goal);
+                auto ida = sf::IDAStar::search(compact, 90, goal, options);
+                assert(ida.found && std::abs(ida.cost - expected.cost) < 1e-9);
+                assert(ida.path.front() == 90 && ida.path.back() == goal);
+                assert(std::abs(walkPath(grid, ida.path) - ida.cost) < 1e-9);
+            }
+            assert(!sf::IDAStar::search(compact, 100, 0, options).found);
+            assert(!sf::IDAStar::search(compact, 0, 4242, options).found);
+        }
+    }
+    
+    // One ParallelIDAStar serves many queries on either graph form
+    sf::ParallelIDAStar parallel(3, 16);
+    assert(parallel.threads() == 3);
+    for (int goal = 7; goal < 100; goal += 23) {
+        auto expected = sf::Dijkstra::search(compact, 90, goal);
+        auto ida = parallel.search(compact, 90, goal);
+        assert(ida.found && std::abs(ida.cost - expected.cost) < 1e-9);
+        assert(std::abs(parallel.search(grid, 90, goal).cost - expected.cost) < 1e-9);
+    }
+    assert(!parallel.search(compact, 0, 4242).found);
+
+    // Tables outlive each search; entries left by earlier queries never prune
+    auto first = sf::IDAStar::search(compact, 90, 55);
+    sf::IDAStar::search(compact, 55, 90);
+    auto again = sf::IDAStar::search(compact, 90, 55);
+    assert(again.path == first.path && again.nodesExplored == first.nodesExplored);
+    
+    std::cout << "PASSED\n";
+}
+
+void testMultiGoalSearch() {
+    std::cout << "Testing multi-goal search... ";
+    
+    // kd-tree nearest agrees with a linear scan under both metrics
+    std::vector<sf::Node> points;
+    unsigned seed = 12345;
+    auto next = [&]() { return nextRandom(seed); };
+    for (int i = 0; i < 300; i++) {
+        points.push_back(sf::Node(i, next() / 10.0, next() / 10.0));
+    }
+    sf::KdTree tree(points);
+    assert(tree.size() == points.size());
+    for (int q = 0; q < 100; q++) {
+        double x = next() / 10.0, y = next() / 10.0;
+        for (auto metric : {sf::KdTree::Metric::Euclidean, sf::KdTree::Metric::Manhattan}) {
+            double expected = 1e18;
+            for (const auto& p : points) {
+                double d = metric == sf::KdTree::Metric::Euclidean
+                    ? std::hypot(p.x - x, p.y - y) : std::abs(p.x - x) + std::abs(p.y - y);
+                expected = std::min(expected, d);
+            }
+            double distance;
+            const sf::Node* nearest = tree.nearest(x, y, metric, distance);
+            assert(nearest && std::abs(distance - expected) < 1e-9);
+        }
+    }
+    double unused;
+    assert(sf::KdTree().nearest(0, 0, sf::KdTree::Metric::Euclidean, unused) == nullptr);
+    
+    // The reached goal is the cheapest one, for every heuristic
+    sf::Graph grid = makeDirectedGrid();
+    grid.addNode(sf::Node(100, 20, 20));
+    sf::CompactGraph compact = grid.freeze();
+    const std::vector<int> goals = {7, 33, 58, 81, 4242};
+    auto custom = [](const sf::Node& a, const sf::Node& b) { return 0.5 * a.distance(b); };
+    std::vector<sf::Heuristic> heuristics = {sf::heuristics::euclidean, sf::heuristics::manhattan,
+                                             sf::heuristics::zero, custom};
+    for (const auto& heuristic : heuristics) {
+        double expected = 1e18;
+        for (int goal : {7, 33, 58, 81}) {
+            expected = std::min(expected, sf::Dijkstra::search(compact, 90, goal).cost);
+        }
+        auto nearest = sf::MultiGoalSearch::search(compact, 90, goals, heuristic);
+        assert(nearest.result.found && std::abs(nearest.result.cost - expected) < 1e-9);
+        assert(nearest.startId == 90 && nearest.result.path.front() == 90);
+        assert(nearest.result.path.back() == nearest.goalId);
+        assert(std::abs(sf::Dijkstra::search(compact, 90, nearest.goalId).cost - expected) < 1e-9);
+        assert(std::abs(walkPath(grid, nearest.result.path) - expected) < 1e-9);
+        
+        // Several starts: the cost includes the offset of the start used
+        std::vector<sf::SearchStart> starts = {{90, 0.0}, {45, 4.0}, {3, 1.5}};
+        expected = 1e18;
+        for (const auto& start : starts) {
+            for (int goal : {7, 33, 58, 81}) {
+                auto r = sf::Dijkstra::search(compact, start.id, goal);
+                if (r.found) expected = std::min(expected, start.offset + r.cost);
+            }
+        }
+        auto multi = sf::MultiGoalSearch::search(grid, starts, goals, heuristic);
+        assert(multi.result.found && std::abs(multi.result.cost - expected) < 1e-9);
+        double offset = -1;
+        for (const auto& start : starts) {
+            if (start.id == multi.startId) offset = start.offset;
+        }
+        assert(std::abs(offset + walkPath(grid, multi.result.path) - expected) < 1e-9);
+    }
+    
+    // A start that is a goal, an isolated start and no known goals
+    auto same = sf::MultiGoalSearch::search(compact, {{33, 2.0}}, goals);
+    assert(same.goalId == 33 && same.result.path.size() == 1 && same.result.cost == 2.0);
+    auto isolated = sf::MultiGoalSearch::search(compact, 100, goals);
+    assert(!isolated.result.found && isolated.goalId == -1);
+    assert(!sf::MultiGoalSearch::search(compact, 90, {4242}).result.found);
+    assert(!sf::MultiGoalSearch::search(compact, 4242, goals).result.found);
+    
+    std::cout << "PASSED\n";
+}
+
+void testPathTreeCache() {
+    std::cout << "Testing path tree cache... ";
+    
+    sf::Graph grid = makeDirectedGrid();
+    grid.addNode(sf::Node(100, 20, 20));
+    sf::CompactGraph compact = grid.freeze();
+    sf::PathTreeCache cache;
+    
+    // Far goal first, then a nearer one is answered from the settled part
+    auto far = cache.search(compact, 0, 99);
+    auto expected = sf::Dijkstra::search(compact, 0, 99);
+    assert(far.found && std::abs(far.cost - expected.cost) < 1e-9);
+    assert(std::abs(walkPath(grid, far.path) - far.cost) < 1e-9);
+    auto nearHit = cache.search(compact, 0, 11);
+    assert(nearHit.found && nearHit.nodesExplored == 0);
+    assert(std::abs(nearHit.cost - sf::Dijkstra::search(compact, 0, 11).cost) < 1e-9);
+    
+    // Every goal from a few sources matches Dijkstra, whatever the order
+    for (int source : {0, 45, 90}) {
+        for (int goal = 99; goal >= 0; goal -= 3) {
+            auto r = cache.search(compact, source, goal);
+            auto d = sf::Dijkstra::search(compact, source, goal);
+            assert(r.found == d.found && std::abs(r.cost - d.cost) < 1e-9);
+            assert(r.path.front() == source && r.path.back() == goal);
+        }
+    }
+    assert(!cache.search(compact, 0, 100).found);
+    assert(cache.search(compact, 0, 100).nodesExplored == 0);  // tree is exhausted
+    assert(!cache.search(compact, 0, 4242).found);
+    
+    sf::PathTreeCacheStats stats = cache.stats();
+    assert(stats.misses == 3 && stats.trees == 3 && stats.evictions == 0);
+    assert(stats.hits > 0 && stats.resumed > 0 && stats.bytes > 0);
+    assert(stats.hitRate() > 0.5 && stats.hitRate() < 1.0);
+    
+    // A new snapshot gets its own trees
+    sf::CompactGraph refrozen = grid.freeze();
+    assert(refrozen.version() != compact.version());
+    cache.search(refrozen, 0, 99);
+    assert(cache.stats().misses == 4);
+    
+    // A budget of about one tree keeps only the most recent one
+    sf::PathTreeCache small(stats.bytes / 2);
+    small.search(compact, 0, 99);
+    small.search(compact, 45, 99);
+    assert(small.stats().trees == 1 && small.stats().evictions == 1);
+    small.search(compact, 45, 0);
+    assert(small.stats().resumed + small.stats().hits == 1);
+    small.clear();
+    assert(small.stats().trees == 0 && small.stats().bytes == 0);
+    
+    // Concurrent queries from shared sources agree with Dijkstra
+    sf::PathTreeCache shared;
+    sf::ThreadPool pool(4);
+    std::vector<double> costs(400);
+    pool.parallelFor(costs.size(), [&](size_t i, size_t) {
+        costs[i] = shared.search(compact, static_cast<int>(i % 4) * 30, static_cast<int>(i / 4)).cost;
+    });
+    for (size_t i = 0; i < costs.size(); i++) {
+        auto d = sf::Dijkstra::search(compact, static_cast<int>(i % 4) * 30, static_cast<int>(i / 4));
+        assert(std::abs(costs[i] - d.cost) < 1e-9);
+    }
+    assert(shared.stats().queries() == costs.size() && shared.stats().misses == 4);
+    
+    std::cout << "PASSED\n";
+}
+
+void testReachability() {
+    std::cout << "Testing reachability index... ";
+    
+    // 0 -> 1 -> 2 -> 0 is a cycle feeding the one-way chain 3 -> 4; 5 - 6 is
+    // a separate undirected pair and 7 is isolated
+    sf::Graph graph;
+    for (int i = 0; i < 8; i++) {
+        graph.addNode(sf::Node(i, i, 0));
+    }
+    graph.addEdge(0, 1, 1.0);
+    graph.addEdge(1, 2, 1.0);
+    graph.addEdge(2, 0, 1.0);
+    graph.addEdge(2, 3, 1.0);
+    graph.addEdge(3, 4, 1.0);
+    graph.addEdgeUndirected(5, 6, 1.0);
+    
+    // Weak components are current without any indexing
+    assert(!graph.reachability().strongIndexed());
+    assert(graph.mayReach(0, 4) && graph.mayReach(4, 0));
+    assert(!graph.mayReach(0, 5) && !graph.mayReach(7, 0) && !graph.mayReach(0, 4242));
+    
+    // Strong components reject paths against the condensation order
+    graph.indexReachability();
+    assert(graph.reachability().strongIndexed());
+    assert(graph.mayReach(0, 4) && graph.mayReach(1, 0) && !graph.mayReach(4, 0));
+    assert(!graph.mayReach(3, 2) && graph.mayReach(5, 6) && graph.mayReach(6, 5));
+    
+    sf::CompactGraph compact = graph.freeze();
+    const auto& index = compact.reachability();
+    int a = compact.indexOf(0), b = compact.indexOf(2), c = compact.indexOf(4);
+    assert(index.strongComponent(a) == index.strongComponent(b));
+    assert(index.strongComponent(a) < index.strongComponent(c));
+    assert(index.weakComponent(a) != index.weakComponent(compact.indexOf(5)));
+    for (int from = 0; from < 8; from++) {
+        for (int to = 0; to < 8; to++) {
+            bool reachable = sf::BFS::search(graph, from, to).found;
+            assert(graph.mayReach(from, to) == compact.mayReach(compact.indexOf(from), compact.indexOf(to)));
+            assert(!reachable || graph.mayReach(from, to));
+            assert(sf::Dijkstra::search(compact, from, to).found == reachable);
+            assert(sf::AStar::search(graph, from, to).found == reachable);
+            assert(sf::BidirectionalDijkstra::search(compact, from, to).found == reachable);
+        }
+    }
+    
+    // Rejected queries never touch the search state
+    sf::ResumableSearch rejected(compact, 4, 0, sf::PlanAlgorithm::Dijkstra);
+    assert(rejected.finish() == sf::SearchStatus::Failed && rejected.nodesExplored() == 0);
+    
+    // A forward edge keeps the strong order, a backward one makes it stale
+    graph.addEdge(0, 4, 1.0);
+    assert(graph.reachability().strongIndexed() && !graph.mayReach(4, 0));
+    graph.addEdge(4, 1, 1.0);
+    assert(!graph.reachability().strongIndexed());
+    assert(graph.mayReach(4, 0) && sf::Dijkstra::search(graph, 4, 0).found);
+    
+    // Edges between components merge them; rebuilding restores the order
+    graph.addEdge(3, 5, 1.0);
+    graph.addEdge(6, 7, 1.0);
+    assert(graph.mayReach(0, 7) && sf::Dijkstra::search(graph, 0, 7).found);
+    graph.indexReachability();
+    assert(graph.mayReach(4, 0) && graph.mayReach(0, 7) && !graph.mayReach(7, 0));
+    
+    graph.clear();
+    assert(graph.reachability().size() == 0 && !graph.mayReach(0, 0));
+    
+    std::cout << "PASSED\n";
+}
+
+// 4x4 intersections joined by polylines of three nodes; every third street
+// is one-way, and a spur and a ring of polyline nodes hang off the corners
+sf::Graph makeCorridorGraph() {
+    sf::Graph graph;
+    for (int i = 0; i < 16; i++) {
+        graph.addNode(sf::Node(i, (i % 4) * 4, (i / 4) * 4));
+    }
+    int next = 100;
+    int street = 0;
+    auto polyline = [&](int a, int b) {
+        const sf::Node& from = graph.getNode(a);
+        const sf::Node& to = graph.getNode(b);
+        bool oneWay = street++ % 3 == 2;
+        int prev = a;
+        for (int k = 1; k <= 4; k++) {
+            int id = b;
+            if (k < 4) {
+                id = next++;
+                graph.addNode(sf::Node(id, from.x + (to.x - from.x) * k / 4,
+                                       from.y + (to.y - from.y) * k / 4));
+            }
+            double w = 1.0 + (id * 7 % 5) * 0.25;
+            graph.addEdge(prev, id, w);
+            if (!oneWay) graph.addEdge(id, prev, w + 0.5);
+            prev = id;
+        }
+    };
+    for (int i = 0; i < 16; i++) {
+        if (i % 4 < 3) polyline(i, i + 1);
+        if (i / 4 < 3) polyline(i, i + 4);
+    }
+    // Spur 15 - 200 - 201 - 202 (dead end) and ring 300..304 through corner 0
+    for (int k = 0; k < 3; k++) graph.addNode(sf::Node(200 + k, 12 + k + 1, 12));
+    graph.addEdgeUndirected(15, 200, 1.0);
+    graph.addEdgeUndirected(200, 201, 1.0);
+    graph.addEdgeUndirected(201, 202, 1.0);
+    for (int k = 0; k < 5; k++) graph.addNode(sf::Node(300 + k, -1 - k, -1));
+    graph.addEdgeUndirected(0, 300, 1.5);
+    for (int k = 0; k < 4; k++) graph.addEdgeUndirected(300 + k, 301 + k, 1.0);
+    graph.addEdgeUndirected(304, 0, 5.5);
+    // A ring with no kept node at all
+    for (int k = 0; k < 4; k++) graph.addNode(sf::Node(400 + k, 30 + k, 30));
+    for (int k = 0; k < 4; k++) graph.addEdgeUndirected(400 + k, 400 + (k + 1) % 4, 2.0);
+    return graph;
+}
+
+void testSimplifiedGraph() {
+    std::cout << "Testing simplified graph... ";
+    
+    sf::Graph graph = makeCorridorGraph();
+    sf::SimplifiedGraph simplified(graph);
+    assert(simplified.originalNodeCount() == graph.nodeCount());
+    // Corners 3 and 12 join two streets and are contracted too; the spur end
+    // and one node of the isolated ring are kept
+    assert(simplified.graph().nodeCount() == 14 + 2);
+    assert(simplified.contracted(3) && simplified.contracted(100) && simplified.contracted(201));
+    assert(!simplified.contracted(0) && !simplified.contracted(202));
+    assert(simplified.chainCount() == 22 + 3);
+    
+    std::vector<int> ids = graph.getNodeIds();
+    std::sort(ids.begin(), ids.end());
+    for (size_t i = 0; i < ids.size(); i += 3) {
+        for (size_t j = 0; j < ids.size(); j += 2) {
+            auto expected = sf::Dijkstra::search(graph, ids[i], ids[j]);
+            for (const auto& heuristic : {sf::Heuristic(sf::heuristics::zero),
+                                          sf::Heuristic(sf::heuristics::euclidean)}) {
+                auto r = simplified.search(ids[i], ids[j], heuristic);
+                assert(r.found == expected.found);
+                if (r.found) {
+                    assert(std::abs(r.cost - expected.cost) < 1e-9);
+                    assert(r.path.front() == ids[i] && r.path.back() == ids[j]);
+                    assert(std::abs(walkPath(graph, r.path) - r.cost) < 1e-9);
+                }
+            }
+        }
+    }
+    
+    // Planners on the reduced graph expand back to original sequences
+    auto reduced = sf::AStar::search(simplified.compact(), 0, 15);
+    auto expanded = simplified.expand(reduced);
+    assert(expanded.found && expanded.path.size() > reduced.path.size());
+    assert(std::abs(walkPath(graph, expanded.path) - reduced.cost) < 1e-9);
+    assert(std::abs(reduced.cost - sf::Dijkstra::search(graph, 0, 15).cost) < 1e-9);
+    
+    assert(!simplified.search(0, 4242).found);
+    assert(!simplified.search(0, 401).found);
+    assert(simplified.search(101, 101).path.size() == 1);
+    
+    std::cout << "PASSED\n";
+}
+
+void testGraphMutation() {
+    std::cout << "Testing graph edge handles / change log... ";
+    
+    sf::Graph graph;
+    for (int i = 0; i < 4; i++) {
+        graph.addNode(sf::Node(i, i, 0));
+    }
+    sf::EdgeHandle a = graph.addEdge(0, 1, 1.0);
+    auto [b, back] = graph.addEdgeUndirected(1, 2, 1.0);
+    sf::EdgeHandle c = graph.addEdge(0, 2, 5.0);
+    sf::EdgeHandle d = graph.addEdge(2, 3, 1.0);
+    assert(graph.findEdge(1, 2) == b && graph.findEdge(2, 1) == back);
+    assert(graph.findEdge(3, 0) == -1);
+    assert(graph.getEdge(c).from == 0 && graph.getEdge(c).to == 2);
+    for (const auto& edge : graph.getNeighbors(0)) {
+        assert(graph.getEdge(edge.handle).to == edge.to);
+    }
+    
+    // Trimming while the log is off is a no-op, however far the version moved
+    sf::Graph unlogged;
+    for (int i = 0; i < 10; i++) {
+        unlogged.addNode(sf::Node(i, i, 0));
+    }
+    unlogged.trimChanges(5);
+    assert(unlogged.version() == 10);
+    graph.trimChanges(graph.version());
+    graph.recordChanges();
+    graph.recordChanges(false);
+    graph.setEdgeWeight(a, 1.0);
+    graph.trimChanges(graph.version());
+    
+    // Every mutation moves the version; the log replays them in order
+    graph.recordChanges();
+    uint64_t before = graph.version();
+    graph.setEdgeWeight(b, 10.0);
+    assert(graph.getEdge(b).weight == 10.0);
+    assert(sf::Dijkstra::search(graph, 0, 3).cost == 6.0);
+    
+    graph.removeEdge(a);  // 0's list swaps c into a's place
+    assert(!graph.hasEdge(a) && graph.getNeighbors(0).size() == 1);
+    assert(graph.getEdge(c).weight == 5.0 && graph.findEdge(0, 1) == -1);
+    graph.setEdgeWeight(c, 2.0);
+    assert(sf::Dijkstra::search(graph, 0, 3).cost == 3.0);
+    
+    graph.blockNode(2);
+    assert(graph.isBlocked(2) && graph.getNeighbors(2).empty());
+    assert(graph.edgeCount() == 0);                     // 0 -> 2 and 1 -> 2 lead in
+    assert(!sf::Dijkstra::search(graph, 0, 2).found);  // an obstacle, not a goal
+    assert(!sf::Dijkstra::search(graph, 0, 3).found);
+    assert(!sf::Dijkstra::search(graph.freeze(), 0, 2).found);
+    graph.setEdgeWeight(d, 4.0);                        // parked edges keep handles
+    graph.blockNode(2, false);
+    assert(sf::Dijkstra::search(graph, 0, 3).cost == 6.0);
+    
+    auto changes = graph.changesSince(before);
+    assert(changes.size() == 6 && graph.version() == before + 6);
+    assert(changes[0].type == sf::GraphChange::Type::WeightChanged && changes[0].edge == b);
+    assert(changes[0].oldWeight == 1.0 && changes[0].weight == 10.0);
+    assert(changes[1].type == sf::GraphChange::Type::EdgeRemoved && changes[1].from == 0 &&
+           changes[1].to == 1);
+    assert(changes[3].type == sf::GraphChange::Type::NodeBlocked && changes[3].from == 2);
+    assert(changes[5].type == sf::GraphChange::Type::NodeUnblocked);
+    for (size_t i = 0; i < changes.size(); i++) {
+        assert(changes[i].version == before + 1 + i);
+    }
+    assert(graph.changesSince(graph.version()).empty());
+    
+    graph.trimChanges(before + 4);
+    assert(graph.changesSince(before + 4).size() == 2);
+    bool threw = false;
+    try {
+        graph.changesSince(before);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        graph.removeEdge(a);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // Replaying the log keeps a persistent planner in step with the graph
+    sf::Graph grid = makeDirectedGrid();
+    sf::CompactGraph frozen = grid.freeze();
+    sf::DStarPlanner planner(frozen, 0, 99);
+    planner.plan();
+    grid.recordChanges();
+    uint64_t seen = grid.version();
+    std::vector<sf::EdgeHandle> handles;
+    for (int id : grid.getNodeIds()) {
+        for (const auto& edge : grid.getNeighbors(id)) {
+            handles.push_back(edge.handle);
+        }
+    }
+    for (size_t i = 0; i < handles.size(); i += 7) {
+        grid.setEdgeWeight(handles[i], grid.getEdge(handles[i]).weight * 3.0);
+    }
+    for (const auto& change : grid.changesSince(seen)) {
+        planner.updateEdgeCost(change.from, change.to, change.weight);
+    }
+    auto r = planner.plan();
+    assert(r.found && std::abs(r.cost - sf::Dijkstra::search(grid, 0, 99).cost) < 1e-9);
+    
+    // Clearing restarts handles, and the log says so
+    uint64_t cleared = grid.version();
+    grid.clear();
+    assert(grid.version() == cleared + 1);
+    assert(grid.changesSince(cleared).front().type == sf::GraphChange::Type::Cleared);
+    
+    std::cout << "PASSED\n";
+}
+
+void testVersionedGraph() {
+    std::cout << "Testing versioned graph snapshots... ";
+    
+    // 30x30 grid spans four edge chunks; node 5000 starts isolated
+    sf::Graph graph;
+    for (int i = 0; i < 900; i++) {
+        graph.addNode(sf::Node(i, i % 30, i / 30));
+    }
+    for (int i = 0; i < 900; i++) {
+        if (i % 30 < 29) graph.addEdgeUndirected(i, i + 1, 1.0 + (i * 7) % 3);
+        if (i / 30 < 29) graph.addEdgeUndirected(i, i + 30, 1.0 + (i * 5) % 4);
+    }
+    graph.addNode(sf::Node(5000, 40, 40));
+    
+    sf::VersionedGraph versioned(graph);
+    sf::GraphSnapshot first = versioned.snapshot();
+    assert(first.version() == 0 && first.nodeCount() == 901);
+    assert(first.edgeCount() == graph.edgeCount());
+    auto expected = sf::Dijkstra::search(graph, 0, 899);
+    auto r = first.search(0, 899);
+    assert(r.found && std::abs(r.cost - expected.cost) < 1e-9);
+    assert(!first.search(0, 5000).found);
+    
+    // Edits stay invisible until published, and old snapshots keep their view
+    versioned.setEdgeWeight(0, 1, 50.0);
+    versioned.removeEdge(0, 30);
+    versioned.addEdge(0, 899, 1.0);
+    versioned.addEdge(899, 5000, 2.0);
+    assert(versioned.stagedChunks() == 2);
+    assert(versioned.snapshot().version() == 0);
+    assert(versioned.publish() == 1);
+    assert(versioned.publish() == 1);   // nothing staged
+    
+    sf::GraphSnapshot second = versioned.snapshot();
+    assert(first.edgeWeight(0, 1) == 1.0 && second.edgeWeight(0, 1) == 50.0);
+    assert(first.edgeWeight(0, 30) < 10.0);
+    assert(second.edgeWeight(0, 30) == std::numeric_limits<double>::infinity());
+    assert(second.edgeCount() == first.edgeCount() + 1);
+    assert(second.sharedChunks(first) == 2);
+    assert(std::abs(first.search(0, 899).cost - expected.cost) < 1e-9);
+    assert(second.search(0, 899).cost == 1.0);
+    auto joined = second.search(0, 5000);
+    assert(joined.found && joined.cost == 3.0 && joined.path.size() == 3);
+    
+    bool threw = false;
+    try {
+        versioned.removeEdge(0, 30);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw && versioned.stagedChunks() == 1);   // the chunk was copied first
+    threw = false;
+    try {
+        versioned.addEdge(0, 4242, 1.0);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // Readers pin consistent versions while the writer keeps publishing
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        for (int round = 0; round < 200; round++) {
+            for (int k = 0; k < 20; k++) {
+                int from = (round * 37 + k * 101) % 899;
+                int to = from % 30 < 29 ? from + 1 : from + 30;
+                versioned.setEdgeWeight(from, to, 1.0 + (round + k) % 5);
+            }
+            versioned.publish();
+        }
+        done = true;
+    });
+    std::vector<std::thread> readers;
+    std::atomic<int> checked(0);
+    for (int t = 0; t < 3; t++) {
+        readers.emplace_back([&, t]() {
+            uint64_t last = 0;
+            sf::SearchWorkspace workspace;
+            while (!done || checked < 30) {
+                sf::GraphSnapshot snapshot = versioned.snapshot();
+                assert(snapshot.version() >= last);
+                last = snapshot.version();
+                auto path = snapshot.search(t * 10, 870 + t, sf::heuristics::euclidean, workspace);
+                double cost = 0.0;
+                for (size_t i = 0; i + 1 < path.path.size(); i++) {
+                    cost += snapshot.edgeWeight(path.path[i], path.path[i + 1]);
+                }
+                assert(path.found && std::abs(cost - path.cost) < 1e-9);
+                checked++;
+            }
+        });
+    }
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    assert(versioned.version() == 201);
+    
+    std::cout << "PASSED\n";
+}
+
+void testDStarPlanner() {
+    std::cout << "Testing D* planner... ";
+    
+    sf::Graph grid = makePlannerGrid();
+    sf::CompactGraph compact = grid.freeze();
+    std::vector<sf::Edge> edges = edgeList(grid);  // current costs
+    
+    sf::DStarPlanner planner(compact, 0, 99);
+    auto first = planner.plan();
+    assert(first.found && std::abs(first.cost - referenceSearch(grid, edges, 0, 99).cost) < 1e-9);
+    assert(planner.plan().nodesExplored == 0);  // nothing changed
+    
+    // A removal away from the current path leaves it alone
+    auto onPath = [&](int id) {
+        return std::find(first.path.begin(), first.path.end(), id) != first.path.end();
+    };
+    for (auto& edge : edges) {
+        if (!onPath(edge.from) && !onPath(edge.to)) {
+            planner.removeEdge(edge.from, edge.to);
+            edge.weight = std::numeric_limits<double>::infinity();
+            break;
+        }
+    }
+    auto same = planner.plan();
+    assert(same.path == first.path && same.nodesExplored < first.nodesExplored);
+    
+    // Walk towards the goal while edges get blocked, raised and lowered;
+    // D* needs no heuristic, so weights may drop below the straight line
+    unsigned seed = 5;
+    auto next = [&]() { return nextRandom(seed); };
+    for (int round = 0; round < 40 && planner.start() != 99; round++) {
+        for (int k = 0; k < 3; k++) {
+            sf::Edge& edge = edges[next() % edges.size()];
+            double weight = next() % 4 == 0 ? std::numeric_limits<double>::infinity()
+                                            : 0.25 * (1 + next() % 12);
+            setMirroredCost(edges, edge.from, edge.to, weight);
+            planner.updateEdgeCost(edge.from, edge.to, weight);
+            assert(planner.edgeCost(edge.from, edge.to) == weight);
+        }
+        auto r = planner.plan();
+        auto expected = referenceSearch(grid, edges, planner.start(), 99);
+        assert(r.found == expected.found);
+        if (!r.found) {
+            break;
+        }
+        assert(std::abs(r.cost - expected.cost) < 1e-9);
+        assert(r.path.front() == planner.start() && r.path.back() == 99);
+        planner.moveStart(r.path[1]);
+    }
+    
+    bool threw = false;
+    try {
+        planner.removeEdge(0, 99);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        sf::DStarPlanner(compact, 4242, 0);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    sf::DStarPlanner isolated(compact, 0, 100);
+    assert(!isolated.plan().found);
+    
+    // The one-shot update applies its removed edges instead of ignoring them
+    auto plain = sf::DStar::search(grid, 0, 99);
+    assert(plain.found && std::abs(plain.cost - sf::Dijkstra::search(grid, 0, 99).cost) < 1e-9);
+    std::vector<std::pair<int, int>> removed;
+    for (size_t i = 0; i + 1 < plain.path.size(); i++) {
+        removed.emplace_back(plain.path[i], plain.path[i + 1]);
+    }
+    auto detour = sf::DStar::update(grid, 0, 99, removed);
+    assert(!detour.found || detour.cost > plain.cost);
+    sf::Graph pruned;
+    for (const auto& [id, node] : grid.getNodes()) {
+        pruned.addNode(node);
+    }
+    for (int id : grid.getNodeIds()) {
+        for (const auto& edge : grid.getNeighbors(id)) {
+            if (std::find(removed.begin(), removed.end(), std::make_pair(edge.from, edge.to)) ==
+                removed.end()) {
+                pruned.addEdge(edge.from, edge.to, edge.weight);
+            }
+        }
+    }
+    auto expectedDetour = sf::Dijkstra::search(pruned, 0, 99);
+    assert(detour.found == expectedDetour.found);
+    assert(!detour.found || std::abs(detour.cost - expectedDetour.cost) < 1e-9);
+    
+    std::cout << "PASSED\n";
+}
+
+void testDStarLitePlanner() {
+    std::cout << "Testing D* Lite planner... ";
+    
+    sf::Graph grid = makePlannerGrid();
+    sf::CompactGraph compact = grid.freeze();
+    std::vector<sf::Edge> edges = edgeList(grid);  // current costs
+    
+    sf::DStarLitePlanner planner(compact, 0, 99);
+    auto first = planner.plan();
+    assert(first.found && std::abs(first.cost - referenceSearch(grid, edges, 0, 99).cost) < 1e-9);
+    assert(planner.plan().nodesExplored == 0);  // nothing changed
+    
+    // Walk towards the goal while edges get blocked, raised and lowered
+    unsigned seed = 7;
+    auto next = [&]() { return nextRandom(seed); };
+    for (int round = 0; round < 40 && planner.start() != 99; round++) {
+        for (int k = 0; k < 3; k++) {
+            sf::Edge& edge = edges[next() % edges.size()];
+            double weight = next() % 4 == 0 ? std::numeric_limits<double>::infinity()
+                                            : edge.weight * (0.5 + next() % 3);
+            weight = std::max(weight, grid.getNode(edge.from).distance(grid.getNode(edge.to)));
+            setMirroredCost(edges, edge.from, edge.to, weight);
+            planner.updateEdgeCost(edge.from, edge.to, weight);
+            assert(planner.edgeCost(edge.from, edge.to) == weight);
+        }
+        auto r = planner.plan();
+        auto expected = referenceSearch(grid, edges, planner.start(), 99);
+        assert(r.found == expected.found);
+        if (!r.found) {
+            break;
+        }
+        assert(std::abs(r.cost - expected.cost) < 1e-9);
+        assert(r.path.front() == planner.start() && r.path.back() == 99);
+        planner.moveStart(r.path[1]);
+    }
+    
+    // Unknown ids and missing edges throw; unreachable goals fail at once
+    bool threw = false;
+    try {
+        planner.updateEdgeCost(0, 99, 1.0);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        sf::DStarLitePlanner(compact, 0, 4242);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    sf::DStarLitePlanner isolated(compact, 0, 100);
+    assert(!isolated.plan().found);
+    
+    // The one-shot entry point is a real D* Lite now
+    auto once = sf::DStarLite::search(grid, 5, 94);
+    assert(once.found && std::abs(once.cost - sf::Dijkstra::search(grid, 5, 94).cost) < 1e-9);
+    
+    // update() blocks the changed edges instead of ignoring them
+    std::vector<std::pair<int, int>> changed = {{5, 94}};   // no such edge
+    std::vector<sf::Edge> original = edgeList(grid);
+    for (size_t i = 0; i + 1 < once.path.size(); i++) {
+        changed.emplace_back(once.path[i], once.path[i + 1]);
+        setMirroredCost(original, once.path[i], once.path[i + 1],
+                        std::numeric_limits<double>::infinity());
+    }
+    auto detour = sf::DStarLite::update(grid, 5, 94, changed);
+    auto expectedDetour = referenceSearch(grid, original, 5, 94);
+    assert(detour.found == expectedDetour.found);
+    assert(!detour.found || std::abs(detour.cost - expectedDetour.cost) < 1e-9);
+    
+    std::cout << "PASSED\n";
+}
+
+void testLPAStarPlanner() {
+    std::cout << "Testing LPA* planner... ";
+    
+    sf::Graph grid = makePlannerGrid();
+    sf::CompactGraph compact = grid.freeze();
+    std::vector<sf::Edge> edges = edgeList(grid);  // last notified costs
+    std::vector<int> blocked;
+    auto isBlocked = [&](int id) {
+        return std::find(blocked.begin(), blocked.end(), id) != blocked.end();
+    };
+    // Edges at blocked nodes are closed whatever their notified cost
+    auto reference = [&]() {
+        std::vector<sf::Edge> open = edges;
+        for (auto& edge : open) {
+            if (isBlocked(edge.from) || isBlocked(edge.to)) {
+                edge.weight = std::numeric_limits<double>::infinity();
+            }
+        }
+        return referenceSearch(grid, open, 3, 96);
+    };
+    
+    sf::LPAStarPlanner planner(compact, 3, 96);
+    auto first = planner.computeShortestPath();
+    assert(first.found && std::abs(first.cost - reference().cost) < 1e-9);
+    assert(planner.computeShortestPath().nodesExplored == 0);
+    
+    unsigned seed = 11;
+    auto next = [&]() { return nextRandom(seed); };
+    for (int round = 0; round < 60; round++) {
+        if (round % 3 == 0) {
+            // Block a node on the current path or next to a blocked one, or
+            // bring back any blocked node
+            int node = -1;
+            bool block = blocked.empty() || next() % 3 != 0;
+            if (block) {
+                auto path = planner.computeShortestPath().path;
+                if (!blocked.empty() && next() % 2 == 0) {
+                    for (const auto& edge : grid.getNeighbors(blocked[next() % blocked.size()])) {
+                        if (!isBlocked(edge.to) && edge.to != 3 && edge.to != 96) {
+                            node = edge.to;
+                        }
+                    }
+                } else if (path.size() >= 3) {
+                    node = path[1 + next() % (path.size() - 2)];
+                }
+                if (node < 0) continue;
+                blocked.push_back(node);
+            } else {
+                size_t i = next() % blocked.size();
+                node = blocked[i];
+                blocked.erase(blocked.begin() + i);
+            }
+            planner.notifyNodeBlocked(node, block);
+        } else {
+            sf::Edge& edge = edges[next() % edges.size()];
+            double weight = std::max(edge.weight * (0.5 + next() % 3),
+                                     grid.getNode(edge.from).distance(grid.getNode(edge.to)));
+            setMirroredCost(edges, edge.from, edge.to, weight);
+            planner.notifyEdgeChanged(edge.from, edge.to, weight);
+            if (!isBlocked(edge.from) && !isBlocked(edge.to)) {
+                assert(planner.edgeCost(edge.from, edge.to) == weight);
+            }
+        }
+        auto r = planner.computeShortestPath();
+        auto expected = reference();
+        assert(r.found == expected.found);
+        if (r.found) {
+            assert(std::abs(r.cost - expected.cost) < 1e-9);
+            assert(r.path.front() == 3 && r.path.back() == 96);
+            for (int id : r.path) {
+                assert(!isBlocked(id));
+            }
+        }
+    }
+    
+    // Unblocking a neighbour must not reopen edges into a node still blocked
+    sf::Graph line;
+    for (int i = 0; i < 4; i++) {
+        line.addNode(sf::Node(i, i, 0));
+    }
+    line.addEdge(0, 1, 1.0);
+    line.addEdge(1, 2, 1.0);
+    line.addEdge(2, 3, 1.0);
+    line.addEdge(0, 3, 100.0);
+    sf::CompactGraph lineCompact = line.freeze();
+    sf::LPAStarPlanner adjacent(lineCompact, 0, 3, sf::heuristics::zero);
+    adjacent.notifyEdgeChanged(0, 1, 2.0);
+    adjacent.notifyNodeBlocked(2);
+    adjacent.notifyNodeBlocked(1);
+    adjacent.notifyNodeBlocked(1, false);
+    adjacent.notifyNodeBlocked(3);
+    adjacent.notifyNodeBlocked(3, false);
+    auto around = adjacent.computeShortestPath();
+    assert(around.found && around.cost == 100.0 && around.path.size() == 2);
+    adjacent.notifyNodeBlocked(2, false);
+    auto through = adjacent.computeShortestPath();
+    assert(through.found && through.cost == 4.0);   // 0 -> 1 keeps its notified cost
+    
+    bool threw = false;
+    try {
+        planner.notifyEdgeChanged(0, 99, 1.0);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(!sf::LPAStarPlanner(compact, 0, 100).computeShortestPath().found);
+    
+    auto once = sf::LPAStar::search(grid, 5, 94);
+    assert(once.found && std::abs(once.cost - sf::Dijkstra::search(grid, 5, 94).cost) < 1e-9);
+    
+    // update() blocks the changed nodes instead of ignoring them
+    std::vector<int> changed = {once.path[once.path.size() / 2], 4242};
+    std::vector<sf::Edge> open = edgeList(grid);
+    for (auto& edge : open) {
+        if (edge.from == changed[0] || edge.to == changed[0]) {
+            edge.weight = std::numeric_limits<double>::infinity();
+        }
+    }
+    auto detour = sf::LPAStar::update(grid, 5, 94, changed);
+    auto expectedDetour = referenceSearch(grid, open, 5, 94);
+    assert(detour.found == expectedDetour.found);
+    assert(!detour.found || std::abs(detour.cost - expectedDetour.cost) < 1e-9);
+    assert(std::find(detour.path.begin(), detour.path.end(), changed[0]) == detour.path.end());
+    assert(!sf::LPAStar::update(grid, 5, 94, {94}).found);
+    
+    std::cout << "PASSED\n";
+}
+
 int main() {
     std::cout << "\n";
     std::cout << "========================================\n";
@@ -280,6 +2111,32 @@ int main() {
         testHeuristics();
         testNoPath();
         testPathResultStructure();
+        testCompactGraph();
+        testSearchWorkspace();
+        testIndexedHeap();
+        testIntegerQueues();
+        testBidirectional();
+        testContractionHierarchy();
+        testLandmarks();
+        testSearchEngine();
+        testThreadPool();
+        testBatchPlanner();
+        testDistanceMatrix();
+        testDeltaStepping();
+        testParallelBFS();
+        testMultiSourceBFS();
+        testARAStar();
+        testResumableSearch();
+        testIDAStarOptions();
+        testMultiGoalSearch();
+        testPathTreeCache();
+        testReachability();
+        testSimplifiedGraph();
+        testGraphMutation();
+        testVersionedGraph();
+        testDStarPlanner();
+        testDStarLitePlanner();
+        testLPAStarPlanner();
         
         std::cout << "\n";
         std::cout << "========================================\n";